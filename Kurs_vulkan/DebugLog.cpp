@@ -0,0 +1,135 @@
+#include "DebugLog.h"
+
+#include <iostream>
+#include <sstream>
+
+DebugLog::~DebugLog()
+{
+	stop();
+}
+
+void DebugLog::start()
+{
+	if (drainThread.joinable())
+		return;
+
+	stopping = false;
+	windowStart = std::chrono::steady_clock::now();
+	drainThread = std::thread(&DebugLog::drainLoop, this);
+}
+
+void DebugLog::stop()
+{
+	if (!drainThread.joinable())
+		return;
+
+	stopping.store(true, std::memory_order_release);
+	drainThread.join();
+
+	for (const auto& pair : entries)								//  ,   - 
+	{
+		const Entry& entry = pair.second;
+		if (entry.suppressed != 0)
+			std::cerr << "Validation " << severityName(entry.record.severity) << " [" << entry.record.messageId << "] " << entry.record.excerpt
+				<< " (suppressed " << entry.suppressed << " of " << entry.count << ")" << '\n';
+	}
+	std::cerr.flush();
+
+	std::cout << "Validation: " << pushedCount.load() << " messages, " << entries.size() << " unique, " << writtenCount << " written, "
+		<< suppressedCount << " suppressed, " << droppedCount.load() << " dropped" << std::endl;
+}
+
+void DebugLog::push(VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT type,
+	const VkDebugUtilsMessengerCallbackDataEXT* data)
+{
+	Record record;
+	record.severity = severity;
+	record.type = type;
+	record.messageId = data->messageIdNumber;
+	record.textHash = 14695981039346656037ull;
+
+	size_t length = 0;
+	for (const char* c = data->pMessage ? data->pMessage : ""; *c != '\0'; c++)	//   ,   
+	{
+		record.textHash = (record.textHash ^ static_cast<uint8_t>(*c)) * 1099511628211ull;
+		if (length + 1 < sizeof(record.excerpt))
+			record.excerpt[length++] = *c;
+	}
+	record.excerpt[length] = '\0';
+
+	pushedCount.fetch_add(1, std::memory_order_relaxed);
+	if (!records.tryPush(record))									// ,  Vulkan,    
+		droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DebugLog::drainLoop()
+{
+	Record record;
+
+	for (;;)
+	{
+		bool stopRequested = stopping.load(std::memory_order_acquire);	//   ,     
+
+		auto now = std::chrono::steady_clock::now();
+		bool any = false;
+		while (records.tryPop(record))
+		{
+			process(record, now);
+			any = true;
+		}
+		if (any)
+			std::cerr.flush();
+
+		if (stopRequested)
+			break;
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));	// : callback   ,     
+	}
+}
+
+void DebugLog::process(const Record& record, std::chrono::steady_clock::time_point now)
+{
+	uint64_t key = record.textHash ^ (static_cast<uint64_t>(static_cast<uint32_t>(record.messageId)) * 0x9E3779B97F4A7C15ull);
+	Entry& entry = entries[key];
+	bool first = entry.count++ == 0;
+	if (first)
+		entry.record = record;
+
+	if (now - windowStart >= std::chrono::seconds(1))
+	{
+		windowStart = now;
+		windowWritten = 0;
+	}
+
+	bool repeatDue = first || now - entry.lastWritten >= repeatInterval;
+	bool withinRate = record.severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT || windowWritten < maxLinesPerSecond;
+
+	if (!repeatDue || !withinRate)
+	{
+		entry.suppressed++;
+		suppressedCount++;
+		return;
+	}
+
+	std::ostringstream line;
+	line << "Validation " << severityName(record.severity) << " [" << record.messageId << "] " << record.excerpt;
+	if (entry.suppressed != 0)
+		line << " (repeated " << entry.suppressed << " more times)";
+	std::cerr << line.str() << '\n';
+
+	entry.suppressed = 0;
+	entry.lastWritten = now;
+	windowWritten++;
+	writtenCount++;
+}
+
+const char* DebugLog::severityName(VkDebugUtilsMessageSeverityFlagBitsEXT severity)
+{
+	if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT)
+		return "ERROR";
+	if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT)
+		return "WARNING";
+	if (severity >= VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT)
+		return "INFO";
+	return "VERBOSE";
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "MpscQueue.h"
+
+class DebugLog														//     
+{
+private:
+	struct Record													//  ,  callback   
+	{
+		VkDebugUtilsMessageSeverityFlagBitsEXT severity;
+		VkDebugUtilsMessageTypeFlagsEXT type;
+		int32_t messageId;											// messageIdNumber  
+		uint64_t textHash;											// FNV-1a   
+		char excerpt[112];											//    
+	};
+	struct Entry													//      
+	{
+		uint64_t count = 0;											//   
+		uint64_t suppressed = 0;									//       
+		std::chrono::steady_clock::time_point lastWritten;			//   
+		Record record;												//   
+	};
+
+	MpscQueue<Record, 256> records;									//   callback   
+	std::thread drainThread;										//     
+	std::atomic<bool> stopping{ false };							//    
+	std::atomic<uint64_t> pushedCount{ 0 };							//  callback
+	std::atomic<uint64_t> droppedCount{ 0 };						//    
+	std::unordered_map<uint64_t, Entry> entries;					//  ,    
+	uint64_t writtenCount = 0;										//  
+	uint64_t suppressedCount = 0;									//     
+	std::chrono::steady_clock::time_point windowStart;				//     
+	uint32_t windowWritten = 0;										//     
+	const uint32_t maxLinesPerSecond = 20;							//     ,  
+	const std::chrono::seconds repeatInterval{ 5 };					//        
+
+	void drainLoop();												//   
+	void process(const Record& record, std::chrono::steady_clock::time_point now);	// ,     
+	static const char* severityName(VkDebugUtilsMessageSeverityFlagBitsEXT severity);
+public:
+	DebugLog() = default;
+	~DebugLog();
+
+	DebugLog(const DebugLog&) = delete;
+	DebugLog& operator=(const DebugLog&) = delete;
+
+	void start();													//   
+	void stop();													//   ,     
+	void push(VkDebugUtilsMessageSeverityFlagBitsEXT severity, VkDebugUtilsMessageTypeFlagsEXT type,
+		const VkDebugUtilsMessengerCallbackDataEXT* data);			//   callback   ,  
+};
@@ -0,0 +1,464 @@
+#include "LodSelector.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+	uint32_t selectLevel(const MeshLodInfo& info, const LodLevel* levels, const float* world, const LodView& view,
+		float threshold, bool& visible, uint32_t& screenSize)		//   ,   lod_select.comp
+	{
+		const float* c = info.boundingSphere;
+		float center[3];
+		for (int k = 0; k < 3; k++)
+			center[k] = world[k] * c[0] + world[4 + k] * c[1] + world[8 + k] * c[2] + world[12 + k];
+
+		float scale = 0.0f;											//    
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const float* column = world + axis * 4;
+			scale = std::max(scale, std::sqrt(column[0] * column[0] + column[1] * column[1] + column[2] * column[2]));
+		}
+		float radius = c[3] * scale;
+
+		visible = true;
+		screenSize = 0;
+		for (int p = 0; p < 6 && visible; p++)
+		{
+			const float* plane = view.frustumPlanes[p];
+			visible = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3] >= -radius;
+		}
+		if (!visible)												//     
+			return 0;
+
+		float d[3] = { center[0] - view.cameraPosition[0], center[1] - view.cameraPosition[1], center[2] - view.cameraPosition[2] };
+		float distance = std::max(std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) - radius, 1e-4f);	//     
+		float errorToPixels = scale * view.projectionScale / distance;
+		screenSize = static_cast<uint32_t>(std::min(2.0f * radius * view.projectionScale / distance, 65535.0f));	//    ,  
+
+		for (uint32_t level = std::max(info.levelCount, 1u) - 1; level > 0; level--)	//   ,    
+		{
+			if (levels[info.firstLevel + level].error * errorToPixels <= threshold)
+				return level;
+		}
+		return 0;
+	}
+}
+
+void LodSelector::init(const VulkanContext& context, const MeshManager& meshManager, uint32_t frameSlots, uint32_t maxDraws,
+	uint64_t triangleBudget)
+{
+	this->context = context;
+	this->meshManager = &meshManager;
+	this->frameSlots = frameSlots;
+	this->maxDraws = maxDraws;
+	this->triangleBudget = triangleBudget;
+
+	VkDeviceSize bufferSize = VkDeviceSize(frameSlots) * maxDraws * sizeof(VkDrawIndexedIndirectCommand);
+	createBuffer(context, bufferSize, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, indirectBuffer, indirectBufferMemory);
+	vkMapMemory(context.device, indirectBufferMemory, 0, bufferSize, 0, &indirectBufferMapped);	//      
+
+	VkDeviceSize objectBufferSize = VkDeviceSize(frameSlots) * getObjectSlotSize();	//      ,   
+	createBuffer(context, objectBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, objectBuffer, objectBufferMemory);
+	vkMapMemory(context.device, objectBufferMemory, 0, objectBufferSize, 0, &objectBufferMapped);
+
+	meshScreenSizes.assign(meshManager.getLodInfos().size(), 0);
+	feedbackSize = sizeof(GpuFeedback) + meshScreenSizes.size() * sizeof(uint32_t);
+	feedbackSlotSize = (feedbackSize + 255) / 256 * 256;							//     minStorageBufferOffsetAlignment,    256
+	VkDeviceSize feedbackBufferSize = VkDeviceSize(frameSlots) * feedbackSlotSize;	//    CPU   
+	createBuffer(context, feedbackBufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, feedbackBuffer, feedbackBufferMemory);
+	vkMapMemory(context.device, feedbackBufferMemory, 0, feedbackBufferSize, 0, &feedbackBufferMapped);
+	memset(feedbackBufferMapped, 0, static_cast<size_t>(feedbackBufferSize));
+	feedbackPending.assign(frameSlots, false);
+}
+
+void LodSelector::initGpu(const std::vector<char>& shaderCode, VkPipelineCache pipelineCache, VkBuffer instanceBuffer, VkDeviceSize slotSize)
+{
+	if (meshManager->getLodLevels().empty())						//       
+		return;
+
+	createGpuPipeline(shaderCode, pipelineCache);
+	createDescriptorSets(instanceBuffer, slotSize);
+}
+
+void LodSelector::createGpuPipeline(const std::vector<char>& shaderCode, VkPipelineCache pipelineCache)
+{
+	std::array<VkDescriptorSetLayoutBinding, 6> bindings{};			// , , , ,  , 
+	for (uint32_t i = 0; i < bindings.size(); i++)
+	{
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	layoutInfo.pBindings = bindings.data();
+
+	if (vkCreateDescriptorSetLayout(context.device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create LOD descriptor set layout!");
+
+	VkPushConstantRange pushConstantRange{};						//   , 128 
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = sizeof(LodView);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount = 1;
+	pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+	if (vkCreatePipelineLayout(context.device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create LOD pipeline layout!");
+
+	VkShaderModuleCreateInfo moduleInfo{};
+	moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+	moduleInfo.codeSize = shaderCode.size();
+	moduleInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
+
+	VkShaderModule shaderModule;
+	if (vkCreateShaderModule(context.device, &moduleInfo, nullptr, &shaderModule) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create LOD shader module!");
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+	pipelineInfo.stage.module = shaderModule;
+	pipelineInfo.stage.pName = "main";
+	pipelineInfo.layout = pipelineLayout;
+
+	VkResult result = vkCreateComputePipelines(context.device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline);
+	vkDestroyShaderModule(context.device, shaderModule, nullptr);
+	if (result != VK_SUCCESS)
+		throw std::runtime_error("Failed to create LOD compute pipeline!");
+}
+
+void LodSelector::createDescriptorSets(VkBuffer instanceBuffer, VkDeviceSize slotSize)
+{
+	VkDescriptorPoolSize poolSize{};
+	poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSize.descriptorCount = 6 * frameSlots;
+
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.poolSizeCount = 1;
+	poolInfo.pPoolSizes = &poolSize;
+	poolInfo.maxSets = frameSlots;
+
+	if (vkCreateDescriptorPool(context.device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create LOD descriptor pool!");
+
+	std::vector<VkDescriptorSetLayout> layouts(frameSlots, descriptorSetLayout);
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool = descriptorPool;
+	allocInfo.descriptorSetCount = frameSlots;
+	allocInfo.pSetLayouts = layouts.data();
+
+	descriptorSets.resize(frameSlots);
+	if (vkAllocateDescriptorSets(context.device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
+		throw std::runtime_error("Failed to allocate LOD descriptor sets!");
+
+	for (uint32_t slot = 0; slot < frameSlots; slot++)				//            
+	{
+		VkDescriptorBufferInfo buffers[6] = {
+			{ meshManager->getLodLevelBuffer(), 0, VK_WHOLE_SIZE },
+			{ meshManager->getLodInfoBuffer(), 0, VK_WHOLE_SIZE },
+			{ objectBuffer, VkDeviceSize(slot) * getObjectSlotSize(), getObjectSlotSize() },
+			{ instanceBuffer, VkDeviceSize(slot) * slotSize, slotSize },
+			{ indirectBuffer, getIndirectOffset(slot), VkDeviceSize(maxDraws) * sizeof(VkDrawIndexedIndirectCommand) },
+			{ feedbackBuffer, VkDeviceSize(slot) * feedbackSlotSize, feedbackSize },
+		};
+
+		VkWriteDescriptorSet writes[6]{};
+		for (uint32_t i = 0; i < 6; i++)
+		{
+			writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[i].dstSet = descriptorSets[slot];
+			writes[i].dstBinding = i;
+			writes[i].descriptorCount = 1;
+			writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writes[i].pBufferInfo = &buffers[i];
+		}
+		vkUpdateDescriptorSets(context.device, 6, writes, 0, nullptr);
+	}
+}
+
+void LodSelector::cleanup()
+{
+	vkDestroyPipeline(context.device, pipeline, nullptr);
+	vkDestroyPipelineLayout(context.device, pipelineLayout, nullptr);
+	vkDestroyDescriptorPool(context.device, descriptorPool, nullptr);	//      
+	vkDestroyDescriptorSetLayout(context.device, descriptorSetLayout, nullptr);
+
+	if (feedbackBufferMapped)
+		vkUnmapMemory(context.device, feedbackBufferMemory);
+	vkDestroyBuffer(context.device, feedbackBuffer, nullptr);
+	vkFreeMemory(context.device, feedbackBufferMemory, nullptr);
+
+	if (objectBufferMapped)
+		vkUnmapMemory(context.device, objectBufferMemory);
+	vkDestroyBuffer(context.device, objectBuffer, nullptr);
+	vkFreeMemory(context.device, objectBufferMemory, nullptr);
+
+	if (indirectBufferMapped)
+		vkUnmapMemory(context.device, indirectBufferMemory);
+	vkDestroyBuffer(context.device, indirectBuffer, nullptr);
+	vkFreeMemory(context.device, indirectBufferMemory, nullptr);
+
+	pipeline = VK_NULL_HANDLE;
+	objects.clear();
+	descriptorSets.clear();
+}
+
+void LodSelector::addObject(uint32_t object, uint32_t mesh)
+{
+	if (objects.size() >= maxDraws)
+		throw std::runtime_error("Too many objects for the indirect draw buffer!");
+	if (mesh >= meshManager->getLodInfos().size() || meshManager->getLodInfos()[mesh].levelCount == 0)
+		throw std::runtime_error("Invalid mesh for LOD object!");
+
+	objects.push_back({ object, mesh });
+}
+
+uint32_t LodSelector::select(TaskPool& pool, const Scene& scene, const LodView& view, uint32_t slot)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	const std::vector<LodLevel>& levels = meshManager->getLodLevels();
+	const std::vector<MeshLodInfo>& infos = meshManager->getLodInfos();
+	float threshold = view.pixelThreshold * thresholdScale;
+	commands.resize(objects.size());
+	screenSizes.resize(objects.size());
+
+	std::atomic<uint64_t> triangles{ 0 };
+	std::atomic<uint64_t> fullDetail{ 0 };
+	std::atomic<uint64_t> levelTotals[maxLevels] = {};
+
+	pool.parallelFor(objects.size(), 256, [&](size_t first, size_t last) {
+		uint64_t batchTriangles = 0;
+		uint64_t batchFull = 0;
+		uint64_t batchLevels[maxLevels] = {};
+
+		for (size_t i = first; i < last; i++)
+		{
+			const MeshLodInfo& info = infos[objects[i].mesh];
+			bool visible;
+			uint32_t level = selectLevel(info, levels.data(), scene.getWorldMatrix(objects[i].object), view, threshold, visible, screenSizes[i]);
+			const LodLevel& chosen = levels[info.firstLevel + level];
+
+			VkDrawIndexedIndirectCommand& command = commands[i];
+			command.indexCount = chosen.indexCount;
+			command.instanceCount = visible ? 1 : 0;
+			command.firstIndex = chosen.firstIndex;
+			command.vertexOffset = info.vertexOffset;
+			command.firstInstance = 0;								//   
+
+			if (visible)
+			{
+				batchTriangles += chosen.indexCount / 3;
+				batchFull += levels[info.firstLevel].indexCount / 3;
+				batchLevels[std::min(level, maxLevels - 1)]++;
+			}
+		}
+
+		triangles.fetch_add(batchTriangles, std::memory_order_relaxed);
+		fullDetail.fetch_add(batchFull, std::memory_order_relaxed);
+		for (uint32_t level = 0; level < maxLevels; level++)
+			levelTotals[level].fetch_add(batchLevels[level], std::memory_order_relaxed);
+	});
+
+	VkDrawIndexedIndirectCommand* target = reinterpret_cast<VkDrawIndexedIndirectCommand*>(
+		static_cast<uint8_t*>(indirectBufferMapped) + getIndirectOffset(slot));
+	GpuObject* table = reinterpret_cast<GpuObject*>(static_cast<uint8_t*>(objectBufferMapped) + VkDeviceSize(slot) * getObjectSlotSize());
+	uint32_t drawCount = 0;
+	std::fill(meshScreenSizes.begin(), meshScreenSizes.end(), 0);
+	for (size_t i = 0; i < commands.size(); i++)					// :      ,  
+	{
+		if (commands[i].instanceCount == 0)
+			continue;
+
+		meshScreenSizes[objects[i].mesh] = std::max(meshScreenSizes[objects[i].mesh], screenSizes[i]);
+		table[drawCount] = { objects[i].mesh, scene.getInstanceIndex(objects[i].object) };	// mesh.vert    gl_InstanceIndex
+		target[drawCount] = commands[i];
+		target[drawCount].firstInstance = drawCount;
+		drawCount++;
+	}
+
+	uint64_t frameLevels[maxLevels];
+	for (uint32_t level = 0; level < maxLevels; level++)
+		frameLevels[level] = levelTotals[level].load();
+	applyFeedback(triangles.load(), fullDetail.load(), drawCount, frameLevels);
+	totalSelectMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	return drawCount;
+}
+
+void LodSelector::applyFeedback(uint64_t frameTriangles, uint64_t frameFullTriangles, uint64_t frameDrawn, const uint64_t* frameLevels)
+{
+	if (triangleBudget != 0)										//  :  ,      
+	{
+		if (frameTriangles > triangleBudget)
+			thresholdScale = std::min(thresholdScale * 1.25f, 64.0f);
+		else if (frameTriangles < triangleBudget * 4 / 5)
+			thresholdScale = std::max(thresholdScale / 1.1f, 1.0f);
+	}
+
+	frameCount++;
+	selectedTriangles += frameTriangles;
+	fullTriangles += frameFullTriangles;
+	maxTriangles = std::max(maxTriangles, frameTriangles);
+	drawnObjects += frameDrawn;
+	culledObjects += objects.size() - std::min<uint64_t>(frameDrawn, objects.size());
+	for (uint32_t level = 0; level < maxLevels; level++)
+		levelCounts[level] += frameLevels[level];
+}
+
+void LodSelector::readGpuFeedback(uint32_t slot)
+{
+	if (!feedbackPending[slot])
+		return;
+
+	GpuFeedback* feedback = reinterpret_cast<GpuFeedback*>(static_cast<uint8_t*>(feedbackBufferMapped) + VkDeviceSize(slot) * feedbackSlotSize);	//  slot ,      
+	uint64_t frameLevels[maxLevels];
+	for (uint32_t level = 0; level < maxLevels; level++)
+		frameLevels[level] = feedback->levelCounts[level];
+	applyFeedback(feedback->triangles, feedback->fullTriangles, feedback->drawnObjects, frameLevels);
+	gpuFrameCount++;
+	memcpy(meshScreenSizes.data(), feedback + 1, meshScreenSizes.size() * sizeof(uint32_t));
+
+	memset(feedback, 0, static_cast<size_t>(feedbackSize));		//   ,    
+	feedbackPending[slot] = false;
+}
+
+uint32_t LodSelector::recordGpuSelect(VkCommandBuffer commandBuffer, const Scene& scene, const LodView& view, uint32_t slot)
+{
+	if (!hasGpuSelect() || objects.empty())
+		return 0;
+
+	readGpuFeedback(slot);											//       
+
+	GpuObject* table = reinterpret_cast<GpuObject*>(static_cast<uint8_t*>(objectBufferMapped) + VkDeviceSize(slot) * getObjectSlotSize());
+	for (size_t i = 0; i < objects.size(); i++)						//      ,  i   i
+		table[i] = { objects[i].mesh, scene.getInstanceIndex(objects[i].object) };
+
+	LodView constants = view;
+	constants.pixelThreshold = view.pixelThreshold * thresholdScale;
+	constants.objectCount = static_cast<uint32_t>(objects.size());
+
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSets[slot], 0, nullptr);
+	vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(LodView), &constants);
+	vkCmdDispatch(commandBuffer, (constants.objectCount + groupSize - 1) / groupSize, 1, 1);
+	feedbackPending[slot] = true;
+
+	VkBufferMemoryBarrier barrier{};								//      
+	barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.buffer = indirectBuffer;
+	barrier.offset = getIndirectOffset(slot);
+	barrier.size = VkDeviceSize(maxDraws) * sizeof(VkDrawIndexedIndirectCommand);
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0,
+		0, nullptr, 1, &barrier, 0, nullptr);
+
+	VkBufferMemoryBarrier feedbackBarrier = barrier;				//    CPU   
+	feedbackBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+	feedbackBarrier.buffer = feedbackBuffer;
+	feedbackBarrier.offset = VkDeviceSize(slot) * feedbackSlotSize;
+	feedbackBarrier.size = feedbackSize;
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+		0, nullptr, 1, &feedbackBarrier, 0, nullptr);
+
+	return constants.objectCount;									//       instanceCount = 0
+}
+
+LodView LodSelector::makeView(const float eye[3], const float target[3], float fovY, float aspect, float zNear, float zFar,
+	float viewportHeight, float pixelThreshold)
+{
+	auto normalize = [](float v[3]) {
+		float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+		for (int k = 0; k < 3; k++)
+			v[k] = length > 0.0f ? v[k] / length : 0.0f;
+	};
+
+	float forward[3] = { target[0] - eye[0], target[1] - eye[1], target[2] - eye[2] };
+	normalize(forward);
+	float right[3] = { -forward[2], 0.0f, forward[0] };				// forward x (0, 1, 0)
+	normalize(right);
+	float up[3] = { right[1] * forward[2] - right[2] * forward[1], right[2] * forward[0] - right[0] * forward[2],
+		right[0] * forward[1] - right[1] * forward[0] };
+
+	float tanY = std::tan(fovY * 0.5f);
+	float tanX = tanY * aspect;
+
+	LodView view{};
+	auto setPlane = [&](int index, float sideSign, const float side[3], float tangent) {	//    : side * sign + forward * tangent
+		float* plane = view.frustumPlanes[index];
+		for (int k = 0; k < 3; k++)
+			plane[k] = side[k] * sideSign + forward[k] * tangent;
+		normalize(plane);
+		plane[3] = -(plane[0] * eye[0] + plane[1] * eye[1] + plane[2] * eye[2]);
+	};
+	setPlane(0, 1.0f, right, tanX);									// 
+	setPlane(1, -1.0f, right, tanX);								// 
+	setPlane(2, 1.0f, up, tanY);									// 
+	setPlane(3, -1.0f, up, tanY);									// 
+
+	float forwardDotEye = forward[0] * eye[0] + forward[1] * eye[1] + forward[2] * eye[2];
+	for (int k = 0; k < 3; k++)
+	{
+		view.frustumPlanes[4][k] = forward[k];						// 
+		view.frustumPlanes[5][k] = -forward[k];						// 
+	}
+	view.frustumPlanes[4][3] = -(forwardDotEye + zNear);
+	view.frustumPlanes[5][3] = forwardDotEye + zFar;
+
+	for (int k = 0; k < 3; k++)
+		view.cameraPosition[k] = eye[k];
+	view.projectionScale = viewportHeight / (2.0f * tanY);
+	view.pixelThreshold = pixelThreshold;
+
+	return view;
+}
+
+void LodSelector::printStats() const
+{
+	if (frameCount == 0)
+		return;
+
+	std::cout << "LOD: " << objects.size() << " objects, " << selectedTriangles / frameCount << " triangles per frame average / "
+		<< maxTriangles << " max (" << fullTriangles / frameCount << " at full detail), " << drawnObjects / frameCount << " drawn, "
+		<< culledObjects / frameCount << " culled, threshold x" << thresholdScale;
+	if (gpuFrameCount != 0)
+		std::cout << ", " << gpuFrameCount << " frames selected on GPU";
+	if (frameCount > gpuFrameCount)
+		std::cout << ", select " << totalSelectMs / (frameCount - gpuFrameCount) << " ms average";
+	std::cout << std::endl;
+
+	std::cout << "  levels:";
+	for (uint32_t level = 0; level < maxLevels; level++)
+	{
+		if (levelCounts[level] != 0)
+			std::cout << " " << level << ": " << levelCounts[level] * 100 / std::max<uint64_t>(drawnObjects, 1) << "%";
+	}
+	std::cout << std::endl;
+}
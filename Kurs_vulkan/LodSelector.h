@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MeshManager.h"
+#include "Scene.h"
+#include "TaskPool.h"
+#include "VulkanUtils.h"
+
+struct LodView														//    ,    push constant  lod_select.comp
+{
+	float frustumPlanes[6][4];										//      ,  
+	float cameraPosition[4];										//   (xyz)
+	float projectionScale;											//       1:   / (2 tg(fovY / 2))
+	float pixelThreshold;											//     
+	uint32_t objectCount;											//    
+	uint32_t padding;
+};
+
+class LodSelector													//              
+{
+private:
+	static const uint32_t maxLevels = 8;							//     
+	static const uint32_t groupSize = 64;							// local_size_x  lod_select.comp
+	struct LodObject												//     
+	{
+		uint32_t object;
+		uint32_t mesh;
+	};
+	struct GpuObject												//     lod_select.comp  mesh.vert
+	{
+		uint32_t mesh;
+		uint32_t instance;											//      
+	};
+	struct GpuFeedback												//    ,    Feedback  lod_select.comp,      
+	{
+		uint32_t triangles;											//      
+		uint32_t fullTriangles;										//      
+		uint32_t drawnObjects;										//  
+		uint32_t padding;
+		uint32_t levelCounts[maxLevels];							//     ,   
+	};
+
+	VulkanContext context;											//      
+	const MeshManager* meshManager = nullptr;						//      
+	std::vector<LodObject> objects;									//   
+	std::vector<VkDrawIndexedIndirectCommand> commands;				//      , instanceCount = 0  
+	std::vector<uint32_t> screenSizes;								//       , 0  
+	std::vector<uint32_t> meshScreenSizes;							//         
+	uint32_t frameSlots = 0;										//    
+	uint32_t maxDraws = 0;											//     
+	VkBuffer indirectBuffer = VK_NULL_HANDLE;						//    ,       
+	VkDeviceMemory indirectBufferMemory = VK_NULL_HANDLE;
+	void* indirectBufferMapped = nullptr;							//    
+	VkBuffer objectBuffer = VK_NULL_HANDLE;							//    :     firstInstance 
+	VkDeviceMemory objectBufferMemory = VK_NULL_HANDLE;
+	void* objectBufferMapped = nullptr;
+	VkBuffer feedbackBuffer = VK_NULL_HANDLE;						//    ,       
+	VkDeviceMemory feedbackBufferMemory = VK_NULL_HANDLE;
+	void* feedbackBufferMapped = nullptr;
+	VkDeviceSize feedbackSize = 0;									//      
+	VkDeviceSize feedbackSlotSize = 0;								//     
+	std::vector<bool> feedbackPending;								//      ,    
+	VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;		//   lod_select.comp
+	VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+	VkPipeline pipeline = VK_NULL_HANDLE;							//   ,   
+	VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+	std::vector<VkDescriptorSet> descriptorSets;					//  ,      
+	uint64_t triangleBudget = 0;									//    , 0  
+	float thresholdScale = 1.0f;									//   ,    
+	uint64_t frameCount = 0;										//    
+	uint64_t gpuFrameCount = 0;										//     
+	uint64_t selectedTriangles = 0;									//       
+	uint64_t fullTriangles = 0;										// ,      
+	uint64_t maxTriangles = 0;										//    
+	uint64_t drawnObjects = 0;										//     
+	uint64_t culledObjects = 0;										//       
+	uint64_t levelCounts[maxLevels] = {};							//     
+	double totalSelectMs = 0.0;										//     CPU
+
+	void createGpuPipeline(const std::vector<char>& shaderCode, VkPipelineCache pipelineCache);	//   
+	void createDescriptorSets(VkBuffer instanceBuffer, VkDeviceSize slotSize);					//      
+	void readGpuFeedback(uint32_t slot);							//         slot
+	void applyFeedback(uint64_t frameTriangles, uint64_t frameFullTriangles, uint64_t frameDrawn, const uint64_t* frameLevels);	//       
+public:
+	void init(const VulkanContext& context, const MeshManager& meshManager, uint32_t frameSlots, uint32_t maxDraws,
+		uint64_t triangleBudget);									//    ,   
+	void initGpu(const std::vector<char>& shaderCode, VkPipelineCache pipelineCache, VkBuffer instanceBuffer,
+		VkDeviceSize slotSize);										//     
+	void cleanup();													//    
+	void addObject(uint32_t object, uint32_t mesh);					//     
+	uint32_t select(TaskPool& pool, const Scene& scene, const LodView& view, uint32_t slot);	//   CPU,         slot,   
+	uint32_t recordGpuSelect(VkCommandBuffer commandBuffer, const Scene& scene, const LodView& view, uint32_t slot);	//        slot,   
+	bool hasGpuSelect() const { return pipeline != VK_NULL_HANDLE; }
+	size_t getObjectCount() const { return objects.size(); }
+	VkBuffer getIndirectBuffer() const { return indirectBuffer; }
+	VkDeviceSize getIndirectOffset(uint32_t slot) const { return VkDeviceSize(slot) * maxDraws * sizeof(VkDrawIndexedIndirectCommand); }
+	VkBuffer getObjectBuffer() const { return objectBuffer; }
+	VkDeviceSize getObjectSlotSize() const { return VkDeviceSize(maxDraws) * sizeof(GpuObject); }
+	float getThresholdScale() const { return thresholdScale; }
+	uint32_t getMeshScreenSize(uint32_t mesh) const { return meshScreenSizes[mesh]; }	//     ,   -      
+
+	static LodView makeView(const float eye[3], const float target[3], float fovY, float aspect, float zNear, float zFar,
+		float viewportHeight, float pixelThreshold);				//       
+	void printStats() const;										//      
+};
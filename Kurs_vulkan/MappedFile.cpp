@@ -0,0 +1,119 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& filename)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);				//    
+	if (file == INVALID_HANDLE_VALUE)
+		throw std::runtime_error("Failed to open file " + filename + "!");
+	fileHandle = file;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		close();
+		throw std::runtime_error("Failed to get size of file " + filename + "!");
+	}
+	mappedSize = static_cast<size_t>(fileSize.QuadPart);
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);		//   
+	if (mapping == nullptr)
+	{
+		close();
+		throw std::runtime_error("Failed to map file " + filename + "!");
+	}
+	mappingHandle = mapping;
+
+	mappedData = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+		throw std::runtime_error("Failed to open file " + filename + "!");
+
+	struct stat fileStat;
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close();
+		throw std::runtime_error("Failed to get size of file " + filename + "!");
+	}
+	mappedSize = static_cast<size_t>(fileStat.st_size);
+
+	void* view = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	mappedData = view == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(view);
+#endif
+	if (mappedData == nullptr)
+	{
+		close();
+		throw std::runtime_error("Failed to map file " + filename + "!");
+	}
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		std::swap(mappedData, other.mappedData);
+		std::swap(mappedSize, other.mappedSize);
+#ifdef _WIN32
+		std::swap(fileHandle, other.fileHandle);
+		std::swap(mappingHandle, other.mappingHandle);
+#else
+		std::swap(fileDescriptor, other.fileDescriptor);
+#endif
+	}
+	return *this;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if (mappedData != nullptr)
+		UnmapViewOfFile(mappedData);
+	if (mappingHandle != nullptr)
+		CloseHandle(mappingHandle);
+	if (fileHandle != nullptr)
+		CloseHandle(fileHandle);
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+#else
+	if (mappedData != nullptr)
+		munmap(const_cast<uint8_t*>(mappedData), mappedSize);
+	if (fileDescriptor >= 0)
+		::close(fileDescriptor);
+	fileDescriptor = -1;
+#endif
+	mappedData = nullptr;
+	mappedSize = 0;
+}
+
+bool MappedFile::exists(const std::string& filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	return file.is_open();
+}
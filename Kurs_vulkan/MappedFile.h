@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+
+class MappedFile													// ,      
+{
+private:
+	const uint8_t* mappedData = nullptr;							//    
+	size_t mappedSize = 0;											//    
+#ifdef _WIN32
+	void* fileHandle = nullptr;										//  
+	void* mappingHandle = nullptr;									//   
+#else
+	int fileDescriptor = -1;										//  
+#endif
+
+	void close();													//     
+public:
+	MappedFile() = default;
+	explicit MappedFile(const std::string& filename);				//    
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	static bool exists(const std::string& filename);				//   
+
+	const uint8_t* data() const { return mappedData; }
+	size_t size() const { return mappedSize; }
+	bool isOpen() const { return mappedData != nullptr; }
+};
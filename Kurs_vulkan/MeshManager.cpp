@@ -0,0 +1,485 @@
+#include "MeshManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+VkVertexInputBindingDescription PackedVertex::getBindingDescription()
+{
+	VkVertexInputBindingDescription bindingDescription{};
+	bindingDescription.binding = 0;
+	bindingDescription.stride = sizeof(PackedVertex);
+	bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+	return bindingDescription;
+}
+
+std::array<VkVertexInputAttributeDescription, 3> PackedVertex::getAttributeDescriptions()
+{
+	std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions{};
+
+	attributeDescriptions[0].binding = 0;											// 
+	attributeDescriptions[0].location = 0;
+	attributeDescriptions[0].format = VK_FORMAT_R16G16B16A16_SNORM;
+	attributeDescriptions[0].offset = offsetof(PackedVertex, position);
+
+	attributeDescriptions[1].binding = 0;											// 
+	attributeDescriptions[1].location = 1;
+	attributeDescriptions[1].format = VK_FORMAT_R8G8B8A8_SNORM;
+	attributeDescriptions[1].offset = offsetof(PackedVertex, normal);
+
+	attributeDescriptions[2].binding = 0;											//  
+	attributeDescriptions[2].location = 2;
+	attributeDescriptions[2].format = VK_FORMAT_R16G16_UNORM;
+	attributeDescriptions[2].offset = offsetof(PackedVertex, uv);
+
+	return attributeDescriptions;
+}
+
+void MeshManager::init(const VulkanContext& context)
+{
+	this->context = context;
+}
+
+void MeshManager::cleanup()
+{
+	destroyBuffers();
+	meshes.clear();
+	lodLevels.clear();
+	lodInfos.clear();
+}
+
+void MeshManager::destroyBuffers()
+{
+	vkDestroyBuffer(context.device, quantizationBuffer, nullptr);
+	vkFreeMemory(context.device, quantizationBufferMemory, nullptr);
+	vkDestroyBuffer(context.device, lodInfoBuffer, nullptr);
+	vkFreeMemory(context.device, lodInfoBufferMemory, nullptr);
+	vkDestroyBuffer(context.device, lodLevelBuffer, nullptr);
+	vkFreeMemory(context.device, lodLevelBufferMemory, nullptr);
+	vkDestroyBuffer(context.device, indexBuffer, nullptr);
+	vkFreeMemory(context.device, indexBufferMemory, nullptr);
+	vkDestroyBuffer(context.device, vertexBuffer, nullptr);
+	vkFreeMemory(context.device, vertexBufferMemory, nullptr);
+
+	quantizationBuffer = lodInfoBuffer = lodLevelBuffer = indexBuffer = vertexBuffer = VK_NULL_HANDLE;
+	quantizationBufferMemory = lodInfoBufferMemory = lodLevelBufferMemory = indexBufferMemory = vertexBufferMemory = VK_NULL_HANDLE;
+}
+
+std::vector<Vertex> MeshManager::parseObj(const std::string& filename)
+{
+	std::ifstream file(filename);
+	if (!file.is_open())
+		throw std::runtime_error("Failed to open file " + filename + "!");
+
+	std::vector<std::array<float, 3>> positions;
+	std::vector<std::array<float, 3>> normals;
+	std::vector<std::array<float, 2>> uvs;
+	std::vector<Vertex> corners;									//    
+
+	auto resolve = [](long index, size_t count) -> long {			//  OBJ   1,    
+		return index < 0 ? static_cast<long>(count) + index : index - 1;
+	};
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::istringstream stream(line);
+		std::string type;
+		stream >> type;
+
+		if (type == "v")
+		{
+			std::array<float, 3> p{};
+			stream >> p[0] >> p[1] >> p[2];
+			positions.push_back(p);
+		}
+		else if (type == "vn")
+		{
+			std::array<float, 3> n{};
+			stream >> n[0] >> n[1] >> n[2];
+			normals.push_back(n);
+		}
+		else if (type == "vt")
+		{
+			std::array<float, 2> t{};
+			stream >> t[0] >> t[1];
+			t[1] = 1.0f - t[1];										//  Vulkan  V  
+			uvs.push_back(t);
+		}
+		else if (type == "f")
+		{
+			std::vector<Vertex> polygon;
+			std::vector<bool> hasNormal;
+			std::string token;
+			while (stream >> token)									//  v, v/vt, v//vn, v/vt/vn
+			{
+				long v = 0, vt = 0, vn = 0;
+				size_t first = token.find('/');
+				size_t second = first == std::string::npos ? std::string::npos : token.find('/', first + 1);
+
+				v = std::stol(token.substr(0, first));
+				if (first != std::string::npos && second != first + 1)
+					vt = std::stol(token.substr(first + 1, second == std::string::npos ? std::string::npos : second - first - 1));
+				if (second != std::string::npos)
+					vn = std::stol(token.substr(second + 1));
+
+				Vertex vertex{};
+				long pi = resolve(v, positions.size());
+				if (pi < 0 || pi >= static_cast<long>(positions.size()))
+					throw std::runtime_error("Invalid position index in " + filename + "!");
+				memcpy(vertex.position, positions[pi].data(), sizeof(vertex.position));
+
+				long ti = vt != 0 ? resolve(vt, uvs.size()) : -1;
+				if (ti >= 0 && ti < static_cast<long>(uvs.size()))
+					memcpy(vertex.uv, uvs[ti].data(), sizeof(vertex.uv));
+
+				long ni = vn != 0 ? resolve(vn, normals.size()) : -1;
+				hasNormal.push_back(ni >= 0 && ni < static_cast<long>(normals.size()));
+				if (hasNormal.back())
+					memcpy(vertex.normal, normals[ni].data(), sizeof(vertex.normal));
+
+				polygon.push_back(vertex);
+			}
+
+			for (size_t i = 1; i + 1 < polygon.size(); i++)		//   
+			{
+				Vertex triangle[3] = { polygon[0], polygon[i], polygon[i + 1] };
+				bool cornerHasNormal[3] = { hasNormal[0], hasNormal[i], hasNormal[i + 1] };
+
+				const float* p0 = triangle[0].position;
+				const float* p1 = triangle[1].position;
+				const float* p2 = triangle[2].position;
+				float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+				float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+				float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+				for (int c = 0; c < 3; c++)
+				{
+					if (!cornerHasNormal[c] && length > 0.0f)				//       
+					{
+						for (int k = 0; k < 3; k++)
+							triangle[c].normal[k] = n[k] / length;
+					}
+					corners.push_back(triangle[c]);
+				}
+			}
+		}
+	}
+
+	return corners;
+}
+
+void MeshManager::quantize(Mesh& mesh, const std::vector<Vertex>& vertices)
+{
+	float minPosition[3] = { INFINITY, INFINITY, INFINITY };
+	float maxPosition[3] = { -INFINITY, -INFINITY, -INFINITY };
+	float minUv[2] = { INFINITY, INFINITY };
+	float maxUv[2] = { -INFINITY, -INFINITY };
+
+	for (const auto& vertex : vertices)								//     
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			minPosition[k] = std::min(minPosition[k], vertex.position[k]);
+			maxPosition[k] = std::max(maxPosition[k], vertex.position[k]);
+		}
+		for (int k = 0; k < 2; k++)
+		{
+			minUv[k] = std::min(minUv[k], vertex.uv[k]);
+			maxUv[k] = std::max(maxUv[k], vertex.uv[k]);
+		}
+	}
+
+	MeshQuantization& q = mesh.quantization;
+	for (int k = 0; k < 3; k++)
+	{
+		q.positionOffset[k] = (minPosition[k] + maxPosition[k]) * 0.5f;
+		q.positionScale[k] = maxPosition[k] > minPosition[k] ? (maxPosition[k] - minPosition[k]) * 0.5f : 1.0f;
+	}
+	q.positionOffset[3] = 0.0f;
+	q.positionScale[3] = 1.0f;
+	for (int k = 0; k < 2; k++)
+	{
+		q.uvScaleOffset[k] = maxUv[k] > minUv[k] ? maxUv[k] - minUv[k] : 1.0f;
+		q.uvScaleOffset[k + 2] = minUv[k];
+	}
+
+	auto snorm = [](float value, float bits) {
+		return std::round(std::max(-1.0f, std::min(1.0f, value)) * bits);
+	};
+	auto unorm = [](float value) {
+		return static_cast<uint16_t>(std::round(std::max(0.0f, std::min(1.0f, value)) * 65535.0f));
+	};
+
+	mesh.vertices.resize(vertices.size());
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const Vertex& source = vertices[i];
+		PackedVertex& packed = mesh.vertices[i];
+
+		for (int k = 0; k < 3; k++)
+		{
+			packed.position[k] = static_cast<int16_t>(snorm((source.position[k] - q.positionOffset[k]) / q.positionScale[k], 32767.0f));
+			packed.normal[k] = static_cast<int8_t>(snorm(source.normal[k], 127.0f));
+		}
+		packed.position[3] = 32767;
+		packed.normal[3] = 0;
+
+		for (int k = 0; k < 2; k++)
+			packed.uv[k] = unorm((source.uv[k] - q.uvScaleOffset[k + 2]) / q.uvScaleOffset[k]);
+	}
+}
+
+void MeshManager::import(Mesh& mesh)
+{
+	std::vector<Vertex> corners = parseObj(mesh.name);
+	if (corners.empty())
+		throw std::runtime_error("Model " + mesh.name + " has no triangles!");
+
+	std::vector<Vertex> vertices;
+	MeshOptimizer::deduplicate(corners, vertices, mesh.indices);						//  
+	mesh.acmrBefore = MeshOptimizer::averageCacheMissRatio(mesh.indices, vertices.size());
+
+	MeshOptimizer::optimizeVertexCache(mesh.indices, vertices.size());				//     
+	MeshOptimizer::optimizeOverdraw(mesh.indices, vertices);							//     
+	mesh.acmrAfter = MeshOptimizer::averageCacheMissRatio(mesh.indices, vertices.size());
+
+	buildLevels(mesh, vertices);														//      
+	MeshOptimizer::optimizeVertexFetch(mesh.indices, vertices);							//      ,      
+
+	quantize(mesh, vertices);
+
+	mesh.vertexData = mesh.vertices.data();
+	mesh.indexData = mesh.indices.data();
+	mesh.levelData = mesh.levels.data();
+	mesh.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+	mesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+	mesh.levelCount = static_cast<uint32_t>(mesh.levels.size());
+}
+
+void MeshManager::buildLevels(Mesh& mesh, const std::vector<Vertex>& vertices)
+{
+	const std::vector<uint32_t> detail = mesh.indices;
+	mesh.levels.assign(1, { 0, static_cast<uint32_t>(detail.size()), 0.0f, 0 });
+
+	size_t previousCount = detail.size();
+	float previousError = 0.0f;
+	while (mesh.levels.size() < maxLodLevels)
+	{
+		size_t targetCount = previousCount / 6 * 3;					//     
+		if (targetCount / 3 < minLodTriangles)
+			break;
+
+		float error;
+		std::vector<uint32_t> level = MeshOptimizer::simplify(vertices, detail, targetCount, error);	//  ,    
+		if (level.size() * 10 > previousCount * 9)					//      
+			break;
+
+		MeshOptimizer::optimizeVertexCache(level, vertices.size());
+		previousError = std::max(previousError, error);				//     ,    
+		mesh.levels.push_back({ static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(level.size()), previousError, 0 });
+		mesh.indices.insert(mesh.indices.end(), level.begin(), level.end());
+		previousCount = level.size();
+	}
+}
+
+bool MeshManager::loadCache(Mesh& mesh, const std::string& cacheName)
+{
+	namespace fs = std::filesystem;
+
+	if (!fs::exists(cacheName) || fs::last_write_time(cacheName) < fs::last_write_time(mesh.name))	//  
+		return false;
+
+	MappedFile file(cacheName);
+	if (file.size() < sizeof(CacheHeader))
+		return false;
+
+	CacheHeader header;
+	memcpy(&header, file.data(), sizeof(header));
+	size_t levelsSize = size_t(header.levelCount) * sizeof(LodLevel);
+	size_t verticesSize = size_t(header.vertexCount) * sizeof(PackedVertex);
+	size_t expectedSize = sizeof(CacheHeader) + levelsSize + verticesSize + size_t(header.indexCount) * sizeof(uint32_t);
+	if (memcmp(header.magic, "KMSH", 4) != 0 || header.version != cacheVersion || file.size() != expectedSize
+		|| header.levelCount == 0 || header.levelCount > maxLodLevels)
+		return false;
+
+	const uint8_t* data = file.data() + sizeof(CacheHeader);										//     
+	const LodLevel* levels = reinterpret_cast<const LodLevel*>(data);
+	for (uint32_t i = 0; i < header.levelCount; i++)
+	{
+		if (size_t(levels[i].firstIndex) + levels[i].indexCount > header.indexCount)
+			return false;
+	}
+
+	const uint32_t* indices = reinterpret_cast<const uint32_t*>(data + levelsSize + verticesSize);
+	for (uint32_t i = 0; i < header.indexCount; i++)
+	{
+		if (indices[i] >= header.vertexCount)						//     OBJ,    
+			return false;
+	}
+
+	mesh.quantization = header.quantization;
+	mesh.vertexCount = header.vertexCount;
+	mesh.indexCount = header.indexCount;
+	mesh.levelCount = header.levelCount;
+	mesh.levelData = levels;
+	mesh.vertexData = reinterpret_cast<const PackedVertex*>(data + levelsSize);
+	mesh.indexData = indices;
+	mesh.cacheFile = std::move(file);
+	mesh.fromCache = true;
+
+	return true;
+}
+
+void MeshManager::saveCache(const Mesh& mesh, const std::string& cacheName)
+{
+	std::ofstream file(cacheName, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return;														//  ,     
+
+	CacheHeader header{};
+	memcpy(header.magic, "KMSH", 4);
+	header.version = cacheVersion;
+	header.vertexCount = mesh.vertexCount;
+	header.indexCount = mesh.indexCount;
+	header.quantization = mesh.quantization;
+	header.levelCount = mesh.levelCount;
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(mesh.levelData), size_t(mesh.levelCount) * sizeof(LodLevel));
+	file.write(reinterpret_cast<const char*>(mesh.vertexData), size_t(mesh.vertexCount) * sizeof(PackedVertex));
+	file.write(reinterpret_cast<const char*>(mesh.indexData), size_t(mesh.indexCount) * sizeof(uint32_t));
+}
+
+void MeshManager::upload()
+{
+	destroyBuffers();
+	lodLevels.clear();
+	lodInfos.clear();
+	if (meshes.empty())
+		return;
+
+	size_t totalVertices = 0;
+	size_t totalIndices = 0;
+	for (const auto& mesh : meshes)									//         
+	{
+		MeshLodInfo info{};
+		for (int k = 0; k < 3; k++)
+			info.boundingSphere[k] = mesh.quantization.positionOffset[k];
+		info.boundingSphere[3] = std::sqrt(mesh.quantization.positionScale[0] * mesh.quantization.positionScale[0]
+			+ mesh.quantization.positionScale[1] * mesh.quantization.positionScale[1]
+			+ mesh.quantization.positionScale[2] * mesh.quantization.positionScale[2]);
+		info.firstLevel = static_cast<uint32_t>(lodLevels.size());
+		info.levelCount = mesh.levelCount;
+		info.vertexOffset = static_cast<int32_t>(totalVertices);
+		lodInfos.push_back(info);
+
+		for (uint32_t i = 0; i < mesh.levelCount; i++)
+		{
+			LodLevel level = mesh.levelData[i];
+			level.firstIndex += static_cast<uint32_t>(totalIndices);
+			lodLevels.push_back(level);
+		}
+
+		totalVertices += mesh.vertexCount;
+		totalIndices += mesh.indexCount;
+	}
+
+	createDeviceLocalBuffer(context, VkDeviceSize(totalVertices) * sizeof(PackedVertex), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+		[this](void* mapped) {
+			uint8_t* target = static_cast<uint8_t*>(mapped);
+			for (const auto& mesh : meshes)
+			{
+				memcpy(target, mesh.vertexData, size_t(mesh.vertexCount) * sizeof(PackedVertex));
+				target += size_t(mesh.vertexCount) * sizeof(PackedVertex);
+			}
+		}, vertexBuffer, vertexBufferMemory);
+	createDeviceLocalBuffer(context, VkDeviceSize(totalIndices) * sizeof(uint32_t), VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+		[this](void* mapped) {
+			uint8_t* target = static_cast<uint8_t*>(mapped);
+			for (const auto& mesh : meshes)
+			{
+				memcpy(target, mesh.indexData, size_t(mesh.indexCount) * sizeof(uint32_t));
+				target += size_t(mesh.indexCount) * sizeof(uint32_t);
+			}
+		}, indexBuffer, indexBufferMemory);
+	createDeviceLocalBuffer(context, lodLevels.data(), VkDeviceSize(lodLevels.size()) * sizeof(LodLevel),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, lodLevelBuffer, lodLevelBufferMemory);
+	createDeviceLocalBuffer(context, lodInfos.data(), VkDeviceSize(lodInfos.size()) * sizeof(MeshLodInfo),
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, lodInfoBuffer, lodInfoBufferMemory);
+	createDeviceLocalBuffer(context, VkDeviceSize(meshes.size()) * sizeof(MeshQuantization), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		[this](void* mapped) {
+			MeshQuantization* target = static_cast<MeshQuantization*>(mapped);
+			for (const auto& mesh : meshes)
+				*target++ = mesh.quantization;
+		}, quantizationBuffer, quantizationBufferMemory);
+}
+
+uint32_t MeshManager::loadMesh(const std::string& filename)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	Mesh mesh;
+	mesh.name = filename;
+
+	std::string cacheName = filename + ".mesh";
+	if (!loadCache(mesh, cacheName))								//       
+	{
+		import(mesh);
+		saveCache(mesh, cacheName);
+	}
+
+	mesh.loadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	meshes.push_back(std::move(mesh));
+
+	return static_cast<uint32_t>(meshes.size() - 1);
+}
+
+void MeshManager::loadDirectory(const std::string& directory)
+{
+	namespace fs = std::filesystem;
+
+	if (!fs::is_directory(directory))
+		return;
+
+	for (const auto& entry : fs::directory_iterator(directory))
+	{
+		if (entry.path().extension() == ".obj")
+			loadMesh(entry.path().string());
+	}
+}
+
+void MeshManager::printStats() const
+{
+	size_t totalVertices = 0;
+	size_t totalIndices = 0;
+	for (const auto& mesh : meshes)
+	{
+		std::cout << "Mesh " << mesh.name << (mesh.fromCache ? " (cache)" : " (imported)") << ": load " << mesh.loadTimeMs << " ms, "
+			<< mesh.vertexCount << " vertices, " << mesh.levelData[0].indexCount / 3 << " triangles, "
+			<< size_t(mesh.vertexCount) * sizeof(PackedVertex) << " vertex bytes (" << size_t(mesh.vertexCount) * sizeof(Vertex) << " unquantized)";
+		if (!mesh.fromCache)
+			std::cout << ", ACMR " << mesh.acmrBefore << " -> " << mesh.acmrAfter;
+		std::cout << std::endl;
+
+		std::cout << "  LOD:";
+		for (uint32_t i = 0; i < mesh.levelCount; i++)
+			std::cout << " " << mesh.levelData[i].indexCount / 3 << " (error " << mesh.levelData[i].error << ")";
+		std::cout << std::endl;
+
+		totalVertices += mesh.vertexCount;
+		totalIndices += mesh.indexCount;
+	}
+
+	if (!meshes.empty())
+		std::cout << "Mesh buffers: " << totalVertices * sizeof(PackedVertex) << " vertex bytes, " << totalIndices * sizeof(uint32_t)
+			<< " index bytes, " << lodLevels.size() << " LOD levels in " << meshes.size() << " meshes" << std::endl;
+}
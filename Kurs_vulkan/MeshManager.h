@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
+#include "VulkanUtils.h"
+
+struct PackedVertex													//  , 16   32
+{
+	int16_t position[4];											//   snorm16   , w  
+	int8_t normal[4];												//   snorm8
+	uint16_t uv[2];													//    unorm16   
+
+	static VkVertexInputBindingDescription getBindingDescription();								//   
+	static std::array<VkVertexInputAttributeDescription, 3> getAttributeDescriptions();		//   
+};
+
+struct MeshQuantization												//    ,      mesh.vert
+{
+	float positionScale[4];											//    
+	float positionOffset[4];										//   
+	float uvScaleOffset[4];											//  (xy)   (zw)  
+};
+
+struct LodLevel														//  ,      lod_select.comp
+{
+	uint32_t firstIndex;											//  :    ,      
+	uint32_t indexCount;											//   
+	float error;													//     
+	uint32_t padding;
+};
+
+struct MeshLodInfo													//      ,    lod_select.comp
+{
+	float boundingSphere[4];										//  (xyz)   (w)     
+	uint32_t firstLevel;											//       
+	uint32_t levelCount;											//  ,   
+	int32_t vertexOffset;											//       
+	uint32_t padding;
+};
+
+class MeshManager													//  OBJ , ,    
+{
+private:
+	struct CacheHeader												//    .mesh
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		MeshQuantization quantization;
+		uint32_t levelCount;										//    ,   
+	};
+	struct Mesh
+	{
+		std::string name;											//    
+		MappedFile cacheFile;										//  ,     
+		std::vector<PackedVertex> vertices;							// ,     
+		std::vector<uint32_t> indices;								//    ,     
+		std::vector<LodLevel> levels;								//  ,     
+		const PackedVertex* vertexData = nullptr;					//       
+		const uint32_t* indexData = nullptr;						//       
+		const LodLevel* levelData = nullptr;						//       
+		uint32_t vertexCount = 0;
+		uint32_t indexCount = 0;
+		uint32_t levelCount = 0;
+		MeshQuantization quantization{};
+		bool fromCache = false;										//     
+		float acmrBefore = 0.0f;									//     
+		float acmrAfter = 0.0f;										//     
+		double loadTimeMs = 0.0;									//  
+	};
+
+	static const uint32_t cacheVersion = 2;							//   
+	static const uint32_t maxLodLevels = 6;							//      
+	static const uint32_t minLodTriangles = 64;						//     
+	VulkanContext context;											// ,      
+	std::vector<Mesh> meshes;										//  
+	std::vector<LodLevel> lodLevels;								//        
+	std::vector<MeshLodInfo> lodInfos;								//     
+	VkBuffer vertexBuffer = VK_NULL_HANDLE;							//     
+	VkDeviceMemory vertexBufferMemory = VK_NULL_HANDLE;
+	VkBuffer indexBuffer = VK_NULL_HANDLE;							//       
+	VkDeviceMemory indexBufferMemory = VK_NULL_HANDLE;
+	VkBuffer lodLevelBuffer = VK_NULL_HANDLE;						//      
+	VkDeviceMemory lodLevelBufferMemory = VK_NULL_HANDLE;
+	VkBuffer lodInfoBuffer = VK_NULL_HANDLE;						//       
+	VkDeviceMemory lodInfoBufferMemory = VK_NULL_HANDLE;
+	VkBuffer quantizationBuffer = VK_NULL_HANDLE;					//     mesh.vert
+	VkDeviceMemory quantizationBufferMemory = VK_NULL_HANDLE;
+
+	static std::vector<Vertex> parseObj(const std::string& filename);	//  OBJ    
+	void import(Mesh& mesh);										//  ,   
+	static void buildLevels(Mesh& mesh, const std::vector<Vertex>& vertices);	//    
+	static void quantize(Mesh& mesh, const std::vector<Vertex>& vertices);	//  
+	bool loadCache(Mesh& mesh, const std::string& cacheName);		//     
+	void saveCache(const Mesh& mesh, const std::string& cacheName);	//  
+	void destroyBuffers();											//   
+public:
+	void init(const VulkanContext& context);						//   
+	void cleanup();													//   
+	uint32_t loadMesh(const std::string& filename);					//  ,   
+	void loadDirectory(const std::string& directory);				//   OBJ   
+	void upload();													//        
+	size_t getMeshCount() const { return meshes.size(); }
+	const std::string& getMeshName(uint32_t mesh) const { return meshes[mesh].name; }
+	uint32_t getIndexCount(uint32_t mesh) const { return meshes[mesh].levelData[0].indexCount; }	//    
+	VkBuffer getVertexBuffer() const { return vertexBuffer; }
+	VkBuffer getIndexBuffer() const { return indexBuffer; }
+	VkBuffer getLodLevelBuffer() const { return lodLevelBuffer; }
+	VkBuffer getLodInfoBuffer() const { return lodInfoBuffer; }
+	VkBuffer getQuantizationBuffer() const { return quantizationBuffer; }
+	const std::vector<LodLevel>& getLodLevels() const { return lodLevels; }
+	const std::vector<MeshLodInfo>& getLodInfos() const { return lodInfos; }
+	const MeshQuantization& getQuantization(uint32_t mesh) const { return meshes[mesh].quantization; }
+	void printStats() const;										//   , ACMR   
+};
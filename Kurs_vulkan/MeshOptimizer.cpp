@@ -0,0 +1,570 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <unordered_map>
+
+namespace
+{
+	struct VertexHash												//     
+	{
+		size_t operator()(const Vertex& vertex) const
+		{
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&vertex);
+			size_t hash = 2166136261u;								// FNV-1a
+			for (size_t i = 0; i < sizeof(Vertex); i++)
+				hash = (hash ^ bytes[i]) * 16777619u;
+			return hash;
+		}
+	};
+
+	struct VertexEqual
+	{
+		bool operator()(const Vertex& a, const Vertex& b) const
+		{
+			return memcmp(&a, &b, sizeof(Vertex)) == 0;
+		}
+	};
+
+	struct PositionHash												//     
+	{
+		size_t operator()(const std::array<float, 3>& position) const
+		{
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(position.data());
+			size_t hash = 2166136261u;
+			for (size_t i = 0; i < sizeof(float) * 3; i++)
+				hash = (hash ^ bytes[i]) * 16777619u;
+			return hash;
+		}
+	};
+
+	struct Quadric													//     : p^T A p + 2 b^T p + c
+	{
+		double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+		double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+		double c = 0.0;
+		double weight = 0.0;										//   
+
+		void addPlane(const double n[3], double d, double w)		//  n * p + d = 0   w
+		{
+			a00 += w * n[0] * n[0]; a11 += w * n[1] * n[1]; a22 += w * n[2] * n[2];
+			a01 += w * n[0] * n[1]; a02 += w * n[0] * n[2]; a12 += w * n[1] * n[2];
+			b0 += w * n[0] * d; b1 += w * n[1] * d; b2 += w * n[2] * d;
+			c += w * d * d;
+			weight += w;
+		}
+
+		void add(const Quadric& other)
+		{
+			a00 += other.a00; a11 += other.a11; a22 += other.a22;
+			a01 += other.a01; a02 += other.a02; a12 += other.a12;
+			b0 += other.b0; b1 += other.b1; b2 += other.b2;
+			c += other.c;
+			weight += other.weight;
+		}
+
+		double evaluate(const float p[3]) const
+		{
+			double x = p[0], y = p[1], z = p[2];
+			double result = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+				+ 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+			return std::max(result, 0.0);
+		}
+	};
+
+	void triangleNormal(const float* p0, const float* p1, const float* p2, double n[3])	//  ,    
+	{
+		double e1[3] = { double(p1[0]) - p0[0], double(p1[1]) - p0[1], double(p1[2]) - p0[2] };
+		double e2[3] = { double(p2[0]) - p0[0], double(p2[1]) - p0[1], double(p2[2]) - p0[2] };
+		n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+		n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+		n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+	}
+
+	float vertexScore(int cachePosition, uint32_t remainingTriangles)	//    
+	{
+		if (remainingTriangles == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+		if (cachePosition >= 0)
+		{
+			if (cachePosition < 3)									//   
+				score = 0.75f;
+			else
+				score = std::pow(1.0f - float(cachePosition - 3) / float(MeshOptimizer::cacheSize - 3), 1.5f);
+		}
+
+		return score + 2.0f / std::sqrt(float(remainingTriangles));	//        
+	}
+}
+
+void MeshOptimizer::deduplicate(const std::vector<Vertex>& corners, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+{
+	std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> uniqueVertices;
+	uniqueVertices.reserve(corners.size());
+
+	vertices.clear();
+	indices.clear();
+	indices.reserve(corners.size());
+
+	for (const auto& corner : corners)
+	{
+		auto inserted = uniqueVertices.emplace(corner, static_cast<uint32_t>(vertices.size()));
+		if (inserted.second)
+			vertices.push_back(corner);
+		indices.push_back(inserted.first->second);
+	}
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return;
+
+	std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);		//     
+	for (uint32_t index : indices)
+		adjacencyOffset[index + 1]++;
+	for (size_t i = 0; i < vertexCount; i++)
+		adjacencyOffset[i + 1] += adjacencyOffset[i];
+
+	std::vector<uint32_t> adjacency(indices.size());
+	std::vector<uint32_t> liveTriangles(vertexCount, 0);			//      
+	for (size_t i = 0; i < indices.size(); i++)
+	{
+		uint32_t vertex = indices[i];
+		adjacency[adjacencyOffset[vertex] + liveTriangles[vertex]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> scores(vertexCount);
+	for (size_t i = 0; i < vertexCount; i++)
+		scores[i] = vertexScore(-1, liveTriangles[i]);
+
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<bool> emitted(triangleCount, false);
+	int bestTriangle = 0;
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		triangleScores[i] = scores[indices[i * 3]] + scores[indices[i * 3 + 1]] + scores[indices[i * 3 + 2]];
+		if (triangleScores[i] > triangleScores[bestTriangle])
+			bestTriangle = static_cast<int>(i);
+	}
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	std::vector<uint32_t> cache, newCache;
+	size_t fallbackCursor = 0;										//  ,      
+
+	while (result.size() < indices.size())
+	{
+		if (bestTriangle < 0)
+		{
+			while (emitted[fallbackCursor])
+				fallbackCursor++;
+			bestTriangle = static_cast<int>(fallbackCursor);
+		}
+
+		const uint32_t* triangle = &indices[bestTriangle * 3];
+		emitted[bestTriangle] = true;
+
+		newCache.assign(triangle, triangle + 3);
+		for (int corner = 0; corner < 3; corner++)					//      
+		{
+			uint32_t vertex = triangle[corner];
+			uint32_t* list = &adjacency[adjacencyOffset[vertex]];
+			uint32_t* last = list + liveTriangles[vertex];
+			*std::find(list, last, static_cast<uint32_t>(bestTriangle)) = *(last - 1);
+			liveTriangles[vertex]--;
+			result.push_back(vertex);
+		}
+
+		for (uint32_t vertex : cache)
+		{
+			if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+				newCache.push_back(vertex);
+		}
+
+		for (size_t i = 0; i < newCache.size(); i++)				//        
+		{
+			uint32_t vertex = newCache[i];
+			cachePosition[vertex] = i < cacheSize ? static_cast<int>(i) : -1;
+			float delta = vertexScore(cachePosition[vertex], liveTriangles[vertex]) - scores[vertex];
+			scores[vertex] += delta;
+
+			for (uint32_t j = 0; j < liveTriangles[vertex]; j++)
+				triangleScores[adjacency[adjacencyOffset[vertex] + j]] += delta;
+		}
+
+		bestTriangle = -1;
+		float bestScore = -1.0f;
+		for (uint32_t vertex : newCache)							//      ,    
+		{
+			for (uint32_t j = 0; j < liveTriangles[vertex]; j++)
+			{
+				uint32_t adjacent = adjacency[adjacencyOffset[vertex] + j];
+				if (triangleScores[adjacent] > bestScore)
+				{
+					bestScore = triangleScores[adjacent];
+					bestTriangle = static_cast<int>(adjacent);
+				}
+			}
+		}
+
+		if (newCache.size() > cacheSize)
+			newCache.resize(cacheSize);
+		cache.swap(newCache);
+	}
+
+	indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices)
+{
+	size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0)
+		return;
+
+	std::vector<size_t> clusters = { 0 };							//  : ,       
+	std::deque<uint32_t> fifo;
+	for (size_t i = 0; i < triangleCount; i++)
+	{
+		int misses = 0;
+		for (int corner = 0; corner < 3; corner++)
+		{
+			uint32_t vertex = indices[i * 3 + corner];
+			if (std::find(fifo.begin(), fifo.end(), vertex) == fifo.end())
+			{
+				misses++;
+				fifo.push_back(vertex);
+				if (fifo.size() > cacheSize)
+					fifo.pop_front();
+			}
+		}
+		if (misses == 3 && i != 0)									//     ,       
+			clusters.push_back(i);
+	}
+	clusters.push_back(triangleCount);
+
+	float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+	for (const auto& vertex : vertices)
+	{
+		for (int k = 0; k < 3; k++)
+			meshCentroid[k] += vertex.position[k] / float(vertices.size());
+	}
+
+	struct Cluster
+	{
+		size_t begin, end;
+		float sortKey;
+	};
+	std::vector<Cluster> sorted;
+
+	for (size_t c = 0; c + 1 < clusters.size(); c++)				//    ,   
+	{
+		float centroid[3] = { 0.0f, 0.0f, 0.0f };
+		float normal[3] = { 0.0f, 0.0f, 0.0f };
+		float totalArea = 0.0f;
+
+		for (size_t i = clusters[c]; i < clusters[c + 1]; i++)
+		{
+			const float* p0 = vertices[indices[i * 3]].position;
+			const float* p1 = vertices[indices[i * 3 + 1]].position;
+			const float* p2 = vertices[indices[i * 3 + 2]].position;
+			float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+			float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+			float n[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+			float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+			for (int k = 0; k < 3; k++)
+			{
+				centroid[k] += (p0[k] + p1[k] + p2[k]) / 3.0f * area;
+				normal[k] += n[k];
+			}
+			totalArea += area;
+		}
+
+		float key = 0.0f;
+		if (totalArea > 0.0f)
+		{
+			float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+			for (int k = 0; k < 3; k++)
+				key += (centroid[k] / totalArea - meshCentroid[k]) * (length > 0.0f ? normal[k] / length : 0.0f);
+		}
+		sorted.push_back({ clusters[c], clusters[c + 1], key });
+	}
+
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) {	//  ,  ,  
+		return a.sortKey > b.sortKey;
+	});
+
+	std::vector<uint32_t> result;
+	result.reserve(indices.size());
+	for (const auto& cluster : sorted)
+		result.insert(result.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+
+	indices.swap(result);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<Vertex>& vertices)
+{
+	const uint32_t unused = ~0u;
+	std::vector<uint32_t> remap(vertices.size(), unused);
+	std::vector<Vertex> result;
+	result.reserve(vertices.size());
+
+	for (uint32_t& index : indices)
+	{
+		if (remap[index] == unused)
+		{
+			remap[index] = static_cast<uint32_t>(result.size());
+			result.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+
+	vertices.swap(result);											//   
+}
+
+float MeshOptimizer::averageCacheMissRatio(const std::vector<uint32_t>& indices, size_t vertexCount)
+{
+	if (indices.empty())
+		return 0.0f;
+
+	std::vector<size_t> timestamp(vertexCount, 0);					//     FIFO 
+	size_t time = cacheSize + 1;
+	size_t misses = 0;
+
+	for (uint32_t index : indices)
+	{
+		if (time - timestamp[index] > cacheSize)
+		{
+			timestamp[index] = time++;
+			misses++;
+		}
+	}
+
+	return float(misses) / float(indices.size() / 3);
+}
+
+std::vector<uint32_t> MeshOptimizer::simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+	size_t targetIndexCount, float& resultError)
+{
+	size_t vertexCount = vertices.size();
+	std::vector<uint32_t> result = indices;
+	resultError = 0.0f;
+
+	std::vector<uint32_t> positionGroup(vertexCount);				//      ,    
+	{
+		std::unordered_map<std::array<float, 3>, uint32_t, PositionHash> groups;
+		groups.reserve(vertexCount);
+		for (uint32_t v = 0; v < vertexCount; v++)
+		{
+			std::array<float, 3> position = { vertices[v].position[0], vertices[v].position[1], vertices[v].position[2] };
+			positionGroup[v] = groups.emplace(position, v).first->second;
+		}
+	}
+
+	std::vector<uint32_t> groupOffset(vertexCount + 1, 0);			//   ,     
+	for (uint32_t v = 0; v < vertexCount; v++)
+		groupOffset[positionGroup[v] + 1]++;
+	for (size_t v = 0; v < vertexCount; v++)
+		groupOffset[v + 1] += groupOffset[v];
+	std::vector<uint32_t> groupMembers(vertexCount);
+	{
+		std::vector<uint32_t> fill(groupOffset.begin(), groupOffset.end() - 1);
+		for (uint32_t v = 0; v < vertexCount; v++)
+			groupMembers[fill[positionGroup[v]]++] = v;
+	}
+
+	std::vector<uint8_t> locked(vertexCount, 0);					//       ,      
+	for (uint32_t v = 0; v < vertexCount; v++)
+	{
+		const Vertex& first = vertices[positionGroup[v]];
+		if (vertices[v].uv[0] != first.uv[0] || vertices[v].uv[1] != first.uv[1])
+			locked[positionGroup[v]] = 1;
+	}
+	{
+		std::unordered_map<uint64_t, uint32_t> edges;				//      
+		edges.reserve(result.size());
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int e = 0; e < 3; e++)
+			{
+				uint32_t a = positionGroup[result[i + e]];
+				uint32_t b = positionGroup[result[i + (e + 1) % 3]];
+				edges[uint64_t(std::min(a, b)) << 32 | std::max(a, b)]++;
+			}
+		}
+		for (const auto& edge : edges)
+		{
+			if (edge.second == 1)
+			{
+				locked[uint32_t(edge.first >> 32)] = 1;
+				locked[uint32_t(edge.first)] = 1;
+			}
+		}
+	}
+
+	std::vector<Quadric> quadrics(vertexCount);						//    ,   
+	for (size_t i = 0; i < result.size(); i += 3)
+	{
+		double n[3];
+		triangleNormal(vertices[result[i]].position, vertices[result[i + 1]].position, vertices[result[i + 2]].position, n);
+		double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (length == 0.0)
+			continue;
+
+		for (int k = 0; k < 3; k++)
+			n[k] /= length;
+		const float* p0 = vertices[result[i]].position;
+		double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+		for (int corner = 0; corner < 3; corner++)
+			quadrics[positionGroup[result[i + corner]]].addPlane(n, d, length * 0.5);
+	}
+
+	auto closestMember = [&](uint32_t group, uint32_t vertex) {		//      
+		const Vertex& source = vertices[vertex];
+		uint32_t best = group;
+		float bestScore = INFINITY;
+		for (uint32_t m = groupOffset[group]; m < groupOffset[group + 1]; m++)
+		{
+			const Vertex& candidate = vertices[groupMembers[m]];
+			float du = candidate.uv[0] - source.uv[0];
+			float dv = candidate.uv[1] - source.uv[1];
+			float dot = candidate.normal[0] * source.normal[0] + candidate.normal[1] * source.normal[1] + candidate.normal[2] * source.normal[2];
+			float score = (du * du + dv * dv) * 100.0f + (1.0f - dot);
+			if (score < bestScore)
+			{
+				bestScore = score;
+				best = groupMembers[m];
+			}
+		}
+		return best;
+	};
+
+	struct Collapse
+	{
+		uint32_t from, to;											//  from     to
+		double cost;
+	};
+	std::vector<Collapse> collapses;
+	std::vector<uint32_t> adjacencyOffset(vertexCount + 1);
+	std::vector<uint32_t> adjacency;
+	std::vector<uint8_t> touched(vertexCount);
+	std::vector<uint32_t> remap(vertexCount);
+	double maxCost = 0.0;
+
+	while (result.size() > targetIndexCount)						// :       
+	{
+		std::fill(adjacencyOffset.begin(), adjacencyOffset.end(), 0);
+		for (uint32_t index : result)
+			adjacencyOffset[positionGroup[index] + 1]++;
+		for (size_t v = 0; v < vertexCount; v++)
+			adjacencyOffset[v + 1] += adjacencyOffset[v];
+		adjacency.resize(result.size());
+		{
+			std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+			for (size_t i = 0; i < result.size(); i++)
+				adjacency[fill[positionGroup[result[i]]]++] = static_cast<uint32_t>(i / 3);
+		}
+
+		collapses.clear();
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			for (int e = 0; e < 3; e++)
+			{
+				uint32_t a = positionGroup[result[i + e]];
+				uint32_t b = positionGroup[result[i + (e + 1) % 3]];
+				for (int direction = 0; direction < 2; direction++, std::swap(a, b))
+				{
+					if (locked[a])
+						continue;
+					Quadric q = quadrics[a];
+					q.add(quadrics[b]);
+					collapses.push_back({ a, b, q.evaluate(vertices[b].position) / std::max(q.weight, 1e-12) });
+				}
+			}
+		}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) {
+			return x.cost < y.cost;
+		});
+
+		std::fill(touched.begin(), touched.end(), 0);
+		for (uint32_t v = 0; v < vertexCount; v++)
+			remap[v] = v;
+
+		size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+		size_t removed = 0;
+		for (const auto& collapse : collapses)
+		{
+			if (removed >= trianglesToRemove)
+				break;
+			if (touched[collapse.from] || touched[collapse.to])		//      
+				continue;
+
+			const float* target = vertices[collapse.to].position;
+			bool flips = false;
+			size_t collapsedTriangles = 0;
+			for (uint32_t t = adjacencyOffset[collapse.from]; t < adjacencyOffset[collapse.from + 1] && !flips; t++)
+			{
+				const uint32_t* triangle = &result[size_t(adjacency[t]) * 3];
+				uint32_t groups[3] = { positionGroup[triangle[0]], positionGroup[triangle[1]], positionGroup[triangle[2]] };
+				if (groups[0] == collapse.to || groups[1] == collapse.to || groups[2] == collapse.to)
+				{
+					collapsedTriangles++;								//      
+					continue;
+				}
+
+				int corner = groups[0] == collapse.from ? 0 : groups[1] == collapse.from ? 1 : 2;
+				const float* p1 = vertices[triangle[(corner + 1) % 3]].position;
+				const float* p2 = vertices[triangle[(corner + 2) % 3]].position;
+				double before[3], after[3];
+				triangleNormal(vertices[collapse.from].position, p1, p2, before);
+				triangleNormal(target, p1, p2, after);
+				double dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+				double lengths = std::sqrt((before[0] * before[0] + before[1] * before[1] + before[2] * before[2])
+					* (after[0] * after[0] + after[1] * after[1] + after[2] * after[2]));
+				flips = dot < 0.25 * lengths;							//     
+			}
+			if (flips || collapsedTriangles == 0)
+				continue;
+
+			for (uint32_t t = adjacencyOffset[collapse.from]; t < adjacencyOffset[collapse.from + 1]; t++)
+			{
+				const uint32_t* triangle = &result[size_t(adjacency[t]) * 3];
+				for (int corner = 0; corner < 3; corner++)
+					touched[positionGroup[triangle[corner]]] = 1;
+			}
+			remap[collapse.from] = collapse.to;
+			quadrics[collapse.to].add(quadrics[collapse.from]);
+			maxCost = std::max(maxCost, collapse.cost);
+			removed += collapsedTriangles;
+		}
+
+		if (removed == 0)											//    
+			break;
+
+		size_t write = 0;
+		for (size_t i = 0; i < result.size(); i += 3)
+		{
+			uint32_t a = remap[positionGroup[result[i]]], b = remap[positionGroup[result[i + 1]]], c = remap[positionGroup[result[i + 2]]];
+			if (a == b || b == c || a == c)
+				continue;
+			for (int corner = 0; corner < 3; corner++)				//      
+			{
+				uint32_t vertex = result[i + corner];
+				uint32_t group = remap[positionGroup[vertex]];
+				result[write++] = group == positionGroup[vertex] ? vertex : closestMember(group, vertex);
+			}
+		}
+		result.resize(write);
+	}
+
+	resultError = static_cast<float>(std::sqrt(maxCost));			//     
+	return result;
+}
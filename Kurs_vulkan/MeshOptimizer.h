@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Vertex														//    ,  
+{
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+
+class MeshOptimizer													//        
+{
+public:
+	static const uint32_t cacheSize = 32;							//      
+
+	static void deduplicate(const std::vector<Vertex>& corners,
+		std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);		//   
+	static void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);	//     ( )
+	static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices);	//     
+	static void optimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<Vertex>& vertices);	//      
+	static std::vector<uint32_t> simplify(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+		size_t targetIndexCount, float& resultError);			//      ,   
+	static float averageCacheMissRatio(const std::vector<uint32_t>& indices, size_t vertexCount);	//       (ACMR)
+};
@@ -0,0 +1,419 @@
+#include "MeshRenderer.h"
+
+#include <array>
+#include <cmath>
+
+void MeshRenderer::init(const VulkanContext& context, const MeshManager& meshManager, const std::vector<char>& vertShaderCode,
+	const std::vector<char>& fragShaderCode, VkRenderPass renderPass, VkPipelineCache pipelineCache, uint32_t frameSlots,
+	VkBuffer objectBuffer, VkDeviceSize objectSlotSize, VkBuffer instanceBuffer, VkDeviceSize instanceSlotSize,
+	const std::vector<uint32_t>& meshTextures, uint32_t textureCount)
+{
+	this->context = context;
+	this->frameSlots = frameSlots;
+
+	if (meshManager.getMeshCount() == 0)							//     ,  
+		return;
+
+	vertexBuffer = meshManager.getVertexBuffer();
+	indexBuffer = meshManager.getIndexBuffer();
+	textureSlots = textureCount + 1;
+
+	std::vector<uint32_t> materials(meshManager.getMeshCount(), 0);	//    
+	for (size_t mesh = 0; mesh < materials.size() && mesh < meshTextures.size(); mesh++)
+		materials[mesh] = meshTextures[mesh] == UINT32_MAX ? 0 : meshTextures[mesh] + 1;
+	createDeviceLocalBuffer(context, materials.data(), materials.size() * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		materialBuffer, materialBufferMemory);
+
+	createPlaceholder();
+	createPipeline(vertShaderCode, fragShaderCode, renderPass, pipelineCache);
+	createDescriptorSets(meshManager, objectBuffer, objectSlotSize, instanceBuffer, instanceSlotSize);
+}
+
+void MeshRenderer::createPlaceholder()
+{
+	VkImageCreateInfo imageInfo{};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.extent = { 1, 1, 1 };
+	imageInfo.mipLevels = 1;
+	imageInfo.arrayLayers = 1;
+	imageInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+	if (vkCreateImage(context.device, &imageInfo, nullptr, &placeholderImage) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create placeholder texture image!");
+
+	VkMemoryRequirements memRequirements;
+	vkGetImageMemoryRequirements(context.device, placeholderImage, &memRequirements);
+
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = memRequirements.size;
+	allocInfo.memoryTypeIndex = findMemoryType(context, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	if (vkAllocateMemory(context.device, &allocInfo, nullptr, &placeholderMemory) != VK_SUCCESS)
+		throw std::runtime_error("Failed to allocate placeholder texture memory!");
+	vkBindImageMemory(context.device, placeholderImage, placeholderMemory, 0);
+
+	VkImageMemoryBarrier barrier{};									//  ,   
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = placeholderImage;
+	barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+	VkCommandBuffer commandBuffer = beginSingleTimeCommands(context);
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	VkClearColorValue white = { { 1.0f, 1.0f, 1.0f, 1.0f } };
+	vkCmdClearColorImage(commandBuffer, placeholderImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &white, 1, &barrier.subresourceRange);
+
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		0, 0, nullptr, 0, nullptr, 1, &barrier);
+	endSingleTimeCommands(context, commandBuffer);
+
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = placeholderImage;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = VK_FORMAT_R8G8B8A8_UNORM;
+	viewInfo.subresourceRange = barrier.subresourceRange;
+
+	if (vkCreateImageView(context.device, &viewInfo, nullptr, &placeholderView) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create placeholder texture image view!");
+
+	VkSamplerCreateInfo samplerInfo{};
+	samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+	samplerInfo.magFilter = VK_FILTER_LINEAR;
+	samplerInfo.minFilter = VK_FILTER_LINEAR;
+	samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+	samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	samplerInfo.maxLod = VK_LOD_CLAMP_NONE;							// View    
+
+	if (vkCreateSampler(context.device, &samplerInfo, nullptr, &sampler) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create texture sampler!");
+}
+
+void MeshRenderer::createPipeline(const std::vector<char>& vertShaderCode, const std::vector<char>& fragShaderCode, VkRenderPass renderPass,
+	VkPipelineCache pipelineCache)
+{
+	std::array<VkDescriptorSetLayoutBinding, 5> bindings{};			// , ,  , , 
+	for (uint32_t i = 0; i < bindings.size(); i++)
+	{
+		bindings[i].binding = i;
+		bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		bindings[i].descriptorCount = 1;
+		bindings[i].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	}
+	bindings[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	bindings[4].descriptorCount = textureSlots;
+	bindings[4].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+	VkDescriptorSetLayoutCreateInfo layoutInfo{};
+	layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+	layoutInfo.pBindings = bindings.data();
+
+	if (vkCreateDescriptorSetLayout(context.device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create mesh descriptor set layout!");
+
+	VkPushConstantRange pushConstantRange{};						//  , 64 
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+	pushConstantRange.offset = 0;
+	pushConstantRange.size = 16 * sizeof(float);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount = 1;
+	pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+	if (vkCreatePipelineLayout(context.device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create mesh pipeline layout!");
+
+	VkShaderModule shaderModules[2];
+	const std::vector<char>* shaderCodes[2] = { &vertShaderCode, &fragShaderCode };
+	for (int i = 0; i < 2; i++)
+	{
+		VkShaderModuleCreateInfo moduleInfo{};
+		moduleInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+		moduleInfo.codeSize = shaderCodes[i]->size();
+		moduleInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCodes[i]->data());
+
+		if (vkCreateShaderModule(context.device, &moduleInfo, nullptr, &shaderModules[i]) != VK_SUCCESS)
+			throw std::runtime_error("Failed to create mesh shader module!");
+	}
+
+	VkPipelineShaderStageCreateInfo shaderStages[2]{};
+	shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+	shaderStages[0].module = shaderModules[0];
+	shaderStages[0].pName = "main";
+	shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	shaderStages[1].module = shaderModules[1];
+	shaderStages[1].pName = "main";
+
+	VkSpecializationMapEntry specializationEntry{ 0, 0, sizeof(uint32_t) };	//     mesh.frag
+	VkSpecializationInfo specializationInfo{};
+	specializationInfo.mapEntryCount = 1;
+	specializationInfo.pMapEntries = &specializationEntry;
+	specializationInfo.dataSize = sizeof(uint32_t);
+	specializationInfo.pData = &textureSlots;
+	shaderStages[1].pSpecializationInfo = &specializationInfo;
+
+	VkVertexInputBindingDescription bindingDescription = PackedVertex::getBindingDescription();
+	std::array<VkVertexInputAttributeDescription, 3> attributeDescriptions = PackedVertex::getAttributeDescriptions();
+
+	VkPipelineVertexInputStateCreateInfo vertexInputInfo{};			//      
+	vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	vertexInputInfo.vertexBindingDescriptionCount = 1;
+	vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+	vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+	vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+
+	VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+	inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+	VkPipelineViewportStateCreateInfo viewportState{};				//       
+	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewportState.viewportCount = 1;
+	viewportState.scissorCount = 1;
+
+	VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+	VkPipelineDynamicStateCreateInfo dynamicState{};
+	dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicState.dynamicStateCount = 2;
+	dynamicState.pDynamicStates = dynamicStates;
+
+	VkPipelineRasterizationStateCreateInfo rasterizer{};
+	rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+	rasterizer.lineWidth = 1.0f;
+	rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+	rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;			// OBJ     ,  y   
+
+	VkPipelineMultisampleStateCreateInfo multisampling{};
+	multisampling.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+	multisampling.minSampleShading = 1.0f;
+
+	VkPipelineDepthStencilStateCreateInfo depthStencil{};			//       
+	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencil.depthTestEnable = VK_TRUE;
+	depthStencil.depthWriteEnable = VK_TRUE;
+	depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+
+	VkPipelineColorBlendAttachmentState colorBlendAttachment{};
+	colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	colorBlendAttachment.blendEnable = VK_FALSE;
+
+	VkPipelineColorBlendStateCreateInfo colorBlending{};
+	colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	colorBlending.attachmentCount = 1;
+	colorBlending.pAttachments = &colorBlendAttachment;
+
+	VkGraphicsPipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	pipelineInfo.stageCount = 2;
+	pipelineInfo.pStages = shaderStages;
+	pipelineInfo.pVertexInputState = &vertexInputInfo;
+	pipelineInfo.pInputAssemblyState = &inputAssembly;
+	pipelineInfo.pViewportState = &viewportState;
+	pipelineInfo.pRasterizationState = &rasterizer;
+	pipelineInfo.pMultisampleState = &multisampling;
+	pipelineInfo.pDepthStencilState = &depthStencil;
+	pipelineInfo.pColorBlendState = &colorBlending;
+	pipelineInfo.pDynamicState = &dynamicState;
+	pipelineInfo.layout = pipelineLayout;
+	pipelineInfo.renderPass = renderPass;
+	pipelineInfo.subpass = 0;
+	pipelineInfo.basePipelineIndex = -1;
+
+	VkResult result = vkCreateGraphicsPipelines(context.device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline);
+	vkDestroyShaderModule(context.device, shaderModules[0], nullptr);
+	vkDestroyShaderModule(context.device, shaderModules[1], nullptr);
+	if (result != VK_SUCCESS)
+		throw std::runtime_error("Failed to create mesh graphics pipeline!");
+}
+
+void MeshRenderer::createDescriptorSets(const MeshManager& meshManager, VkBuffer objectBuffer, VkDeviceSize objectSlotSize,
+	VkBuffer instanceBuffer, VkDeviceSize instanceSlotSize)
+{
+	VkDescriptorPoolSize poolSizes[2]{};
+	poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	poolSizes[0].descriptorCount = 4 * frameSlots;
+	poolSizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	poolSizes[1].descriptorCount = textureSlots * frameSlots;
+
+	VkDescriptorPoolCreateInfo poolInfo{};
+	poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	poolInfo.poolSizeCount = 2;
+	poolInfo.pPoolSizes = poolSizes;
+	poolInfo.maxSets = frameSlots;
+
+	if (vkCreateDescriptorPool(context.device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create mesh descriptor pool!");
+
+	std::vector<VkDescriptorSetLayout> layouts(frameSlots, descriptorSetLayout);
+	VkDescriptorSetAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	allocInfo.descriptorPool = descriptorPool;
+	allocInfo.descriptorSetCount = frameSlots;
+	allocInfo.pSetLayouts = layouts.data();
+
+	descriptorSets.resize(frameSlots);
+	if (vkAllocateDescriptorSets(context.device, &allocInfo, descriptorSets.data()) != VK_SUCCESS)
+		throw std::runtime_error("Failed to allocate mesh descriptor sets!");
+
+	boundViews.assign(frameSlots, std::vector<VkImageView>(textureSlots - 1, VK_NULL_HANDLE));
+	for (uint32_t slot = 0; slot < frameSlots; slot++)				//         
+	{
+		VkDescriptorBufferInfo buffers[4] = {
+			{ objectBuffer, VkDeviceSize(slot) * objectSlotSize, objectSlotSize },
+			{ instanceBuffer, VkDeviceSize(slot) * instanceSlotSize, instanceSlotSize },
+			{ meshManager.getQuantizationBuffer(), 0, VK_WHOLE_SIZE },
+			{ materialBuffer, 0, VK_WHOLE_SIZE },
+		};
+		std::vector<VkDescriptorImageInfo> images(textureSlots, { sampler, placeholderView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });	//    updateTextures
+
+		VkWriteDescriptorSet writes[5]{};
+		for (uint32_t i = 0; i < 5; i++)
+		{
+			writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			writes[i].dstSet = descriptorSets[slot];
+			writes[i].dstBinding = i;
+			writes[i].descriptorCount = 1;
+			writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			writes[i].pBufferInfo = &buffers[i];
+		}
+		writes[4].descriptorCount = textureSlots;
+		writes[4].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writes[4].pBufferInfo = nullptr;
+		writes[4].pImageInfo = images.data();
+		vkUpdateDescriptorSets(context.device, 5, writes, 0, nullptr);
+	}
+}
+
+void MeshRenderer::updateTextures(uint32_t slot, const std::vector<VkImageView>& views)
+{
+	if (!isReady() || views.size() != boundViews[slot].size() || views == boundViews[slot])	//        
+		return;
+
+	std::vector<VkDescriptorImageInfo> images;
+	for (VkImageView view : views)
+		images.push_back({ sampler, view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+
+	VkWriteDescriptorSet write{};
+	write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	write.dstSet = descriptorSets[slot];
+	write.dstBinding = 4;
+	write.dstArrayElement = 1;										//  0 - 
+	write.descriptorCount = static_cast<uint32_t>(images.size());
+	write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	write.pImageInfo = images.data();
+	if (!images.empty())
+		vkUpdateDescriptorSets(context.device, 1, &write, 0, nullptr);
+
+	boundViews[slot] = views;
+}
+
+void MeshRenderer::cleanup()
+{
+	vkDestroyPipeline(context.device, pipeline, nullptr);
+	vkDestroyPipelineLayout(context.device, pipelineLayout, nullptr);
+	vkDestroyDescriptorPool(context.device, descriptorPool, nullptr);	//      
+	vkDestroyDescriptorSetLayout(context.device, descriptorSetLayout, nullptr);
+	vkDestroySampler(context.device, sampler, nullptr);
+	vkDestroyImageView(context.device, placeholderView, nullptr);
+	vkDestroyImage(context.device, placeholderImage, nullptr);
+	vkFreeMemory(context.device, placeholderMemory, nullptr);
+	vkDestroyBuffer(context.device, materialBuffer, nullptr);
+	vkFreeMemory(context.device, materialBufferMemory, nullptr);
+
+	pipeline = VK_NULL_HANDLE;
+	pipelineLayout = VK_NULL_HANDLE;
+	descriptorPool = VK_NULL_HANDLE;
+	descriptorSetLayout = VK_NULL_HANDLE;
+	descriptorSets.clear();
+	boundViews.clear();
+	sampler = VK_NULL_HANDLE;
+	placeholderView = VK_NULL_HANDLE;
+	placeholderImage = VK_NULL_HANDLE;
+	placeholderMemory = VK_NULL_HANDLE;
+	materialBuffer = VK_NULL_HANDLE;
+	materialBufferMemory = VK_NULL_HANDLE;
+}
+
+void MeshRenderer::recordDraws(VkCommandBuffer commandBuffer, uint32_t slot, const float viewProjection[16], VkBuffer indirectBuffer,
+	VkDeviceSize indirectOffset, uint32_t drawCount)
+{
+	if (!isReady() || drawCount == 0)
+		return;
+
+	VkDeviceSize vertexOffset = 0;
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSets[slot], 0, nullptr);
+	vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, 16 * sizeof(float), viewProjection);
+	vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &vertexOffset);
+	vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+	vkCmdDrawIndexedIndirect(commandBuffer, indirectBuffer, indirectOffset, drawCount, sizeof(VkDrawIndexedIndirectCommand));	//      gl_InstanceIndex = firstInstance
+}
+
+void MeshRenderer::makeViewProjection(const float eye[3], const float target[3], float fovY, float aspect, float zNear, float zFar,
+	float result[16])
+{
+	auto normalize = [](float v[3]) {
+		float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+		for (int k = 0; k < 3; k++)
+			v[k] = length > 0.0f ? v[k] / length : 0.0f;
+	};
+
+	float forward[3] = { target[0] - eye[0], target[1] - eye[1], target[2] - eye[2] };
+	normalize(forward);
+	float right[3] = { -forward[2], 0.0f, forward[0] };				//   ,   LodSelector::makeView
+	normalize(right);
+	float up[3] = { right[1] * forward[2] - right[2] * forward[1], right[2] * forward[0] - right[0] * forward[2],
+		right[0] * forward[1] - right[1] * forward[0] };
+
+	float f = 1.0f / std::tan(fovY * 0.5f);
+	float depthScale = zFar / (zNear - zFar);						//  0   , 1  
+	float depthOffset = zNear * zFar / (zNear - zFar);
+
+	float view[3][4];												//   : right, up, -forward
+	for (int k = 0; k < 3; k++)
+	{
+		view[0][k] = right[k];
+		view[1][k] = up[k];
+		view[2][k] = -forward[k];
+	}
+	for (int row = 0; row < 3; row++)
+		view[row][3] = -(view[row][0] * eye[0] + view[row][1] * eye[1] + view[row][2] * eye[2]);
+
+	for (int column = 0; column < 4; column++)						//     ,   
+	{
+		result[column * 4 + 0] = f / aspect * view[0][column];
+		result[column * 4 + 1] = -f * view[1][column];				//  y  Vulkan  
+		result[column * 4 + 2] = depthScale * view[2][column] + (column == 3 ? depthOffset : 0.0f);
+		result[column * 4 + 3] = -view[2][column];
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+
+#include "MeshManager.h"
+#include "VulkanUtils.h"
+
+class MeshRenderer													//          
+{
+private:
+	VulkanContext context;											//       
+	uint32_t frameSlots = 0;										//    
+	VkBuffer vertexBuffer = VK_NULL_HANDLE;							//    PackedVertex
+	VkBuffer indexBuffer = VK_NULL_HANDLE;							//     
+	VkBuffer materialBuffer = VK_NULL_HANDLE;						//    , 0 -  
+	VkDeviceMemory materialBufferMemory = VK_NULL_HANDLE;
+	uint32_t textureSlots = 1;										//     mesh.frag:    
+	VkImage placeholderImage = VK_NULL_HANDLE;						//  1x1   0,      
+	VkDeviceMemory placeholderMemory = VK_NULL_HANDLE;
+	VkImageView placeholderView = VK_NULL_HANDLE;
+	VkSampler sampler = VK_NULL_HANDLE;								//     -
+	std::vector<std::vector<VkImageView>> boundViews;				// View     ,    
+	VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;		//   mesh.vert   mesh.frag
+	VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+	VkPipeline pipeline = VK_NULL_HANDLE;							//   
+	VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+	std::vector<VkDescriptorSet> descriptorSets;					//  ,      
+
+	void createPipeline(const std::vector<char>& vertShaderCode, const std::vector<char>& fragShaderCode, VkRenderPass renderPass,
+		VkPipelineCache pipelineCache);								//     PackedVertex
+	void createPlaceholder();										//     
+	void createDescriptorSets(const MeshManager& meshManager, VkBuffer objectBuffer, VkDeviceSize objectSlotSize,
+		VkBuffer instanceBuffer, VkDeviceSize instanceSlotSize);	//   , ,    
+public:
+	void init(const VulkanContext& context, const MeshManager& meshManager, const std::vector<char>& vertShaderCode,
+		const std::vector<char>& fragShaderCode, VkRenderPass renderPass, VkPipelineCache pipelineCache, uint32_t frameSlots,
+		VkBuffer objectBuffer, VkDeviceSize objectSlotSize, VkBuffer instanceBuffer, VkDeviceSize instanceSlotSize,
+		const std::vector<uint32_t>& meshTextures, uint32_t textureCount);	//      , meshTextures -    UINT32_MAX
+	void cleanup();													//     
+	void updateTextures(uint32_t slot, const std::vector<VkImageView>& views);	//   view     slot    
+	void recordDraws(VkCommandBuffer commandBuffer, uint32_t slot, const float viewProjection[16], VkBuffer indirectBuffer,
+		VkDeviceSize indirectOffset, uint32_t drawCount);			//      
+	bool isReady() const { return pipeline != VK_NULL_HANDLE; }
+
+	static void makeViewProjection(const float eye[3], const float target[3], float fovY, float aspect, float zNear, float zFar,
+		float result[16]);											//    Vulkan:  y ,  0..1,  
+};
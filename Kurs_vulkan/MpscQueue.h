@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+template <typename T, size_t Capacity>
+class MpscQueue														//         
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;								//  ,       (pos)   (pos + 1)
+		T item;
+	};
+
+	Cell cells[Capacity];											//   
+	alignas(64) std::atomic<size_t> head{ 0 };						//  ,   
+	alignas(64) std::atomic<size_t> tail{ 0 };						//  ,     CAS
+public:
+	MpscQueue()
+	{
+		for (size_t i = 0; i < Capacity; i++)
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	MpscQueue(const MpscQueue&) = delete;
+	MpscQueue& operator=(const MpscQueue&) = delete;
+
+	bool tryPush(const T& item)										//     , false   
+	{
+		size_t position = tail.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &cells[position & (Capacity - 1)];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (difference == 0)
+			{
+				if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)								//    ,  
+				return false;
+			else													//    
+				position = tail.load(std::memory_order_relaxed);
+		}
+
+		cell->item = item;
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool tryPop(T& item)											//     , false   
+	{
+		size_t position = head.load(std::memory_order_relaxed);
+		Cell& cell = cells[position & (Capacity - 1)];
+
+		if (cell.sequence.load(std::memory_order_acquire) != position + 1)	//       
+			return false;
+
+		item = cell.item;
+		cell.sequence.store(position + Capacity, std::memory_order_release);
+		head.store(position + 1, std::memory_order_relaxed);
+		return true;
+	}
+};
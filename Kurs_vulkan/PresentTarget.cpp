@@ -0,0 +1,410 @@
+#include "PresentTarget.h"
+#include "VulkanUtils.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+void PresentTarget::createWindow(uint32_t width, uint32_t height, const std::string& title)
+{
+	window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);	//  
+	if (window == nullptr)
+		throw std::runtime_error("Failed to create window!");
+
+	glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);	//       
+}
+
+void PresentTarget::createSurface(VkInstance instance)
+{
+	if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create window surface!");
+}
+
+void PresentTarget::createSwapChain(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t graphicsFamily, uint32_t presentFamily, VkFormat requiredFormat)
+{
+	this->physicalDevice = physicalDevice;
+	this->device = device;
+	queueFamilies[0] = graphicsFamily;
+	queueFamilies[1] = presentFamily;
+
+	SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice, surface);
+
+	VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats, requiredFormat);
+	VkPresentModeKHR presentMode = shooseSwapPresentMode(swapChainSupport.presentModes);
+	VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
+
+	uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;							//    swap chain
+	if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount)
+		imageCount = swapChainSupport.capabilities.maxImageCount;
+
+	VkSwapchainCreateInfoKHR createInfo{};															//      swap chain
+	createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+	createInfo.surface = surface;
+	createInfo.minImageCount = imageCount;
+	createInfo.imageFormat = surfaceFormat.format;
+	createInfo.imageColorSpace = surfaceFormat.colorSpace;
+	createInfo.imageExtent = extent;
+	createInfo.imageArrayLayers = 1;
+	createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+	if (graphicsFamily != presentFamily)
+	{
+		createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
+		createInfo.queueFamilyIndexCount = 2;
+		createInfo.pQueueFamilyIndices = queueFamilies;
+	}
+	else
+	{
+		createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		createInfo.queueFamilyIndexCount = 0;
+		createInfo.pQueueFamilyIndices = nullptr;
+	}
+
+	createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
+	createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+	createInfo.presentMode = presentMode;
+	createInfo.clipped = VK_TRUE;
+	createInfo.oldSwapchain = VK_NULL_HANDLE;
+
+	if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create swap chain!");
+
+	vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);								//     swap chain
+	swapChainImage.resize(imageCount);
+	vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImage.data());					//    swap chain
+
+	swapChainImageFormat = surfaceFormat.format;
+	swapChainExtent = extent;
+	imagesInFlight.assign(swapChainImage.size(), VK_NULL_HANDLE);
+}
+
+SwapChainSupportDetails PresentTarget::querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface)
+{
+	SwapChainSupportDetails details;
+
+	vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, surface, &details.capabilities);				//  surface capabilities
+
+	uint32_t formatCount;
+	vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &formatCount, nullptr);					//    
+
+	if (formatCount != 0)
+	{
+		details.formats.resize(formatCount);
+		vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &formatCount, details.formats.data());
+	}
+
+	uint32_t presentModeCount;
+	vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &presentModeCount, nullptr);			//     
+
+	if (presentModeCount != 0)
+	{
+		details.presentModes.resize(presentModeCount);
+		vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &presentModeCount, details.presentModes.data());
+	}
+
+	return details;
+}
+
+VkSurfaceFormatKHR PresentTarget::chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats, VkFormat requiredFormat)
+{
+	if (requiredFormat != VK_FORMAT_UNDEFINED)														//   ,      
+	{
+		for (const auto& availableFormat : availableFormats)
+		{
+			if (availableFormat.format == requiredFormat)
+				return availableFormat;
+		}
+
+		throw std::runtime_error("Surface does not support the shared render pass format!");
+	}
+
+	for (const auto& availableFormat : availableFormats)
+	{
+		if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
+			return availableFormat;
+	}
+
+	return availableFormats[0];
+}
+
+VkPresentModeKHR PresentTarget::shooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
+{
+	for (const auto& availablePresentMode : availablePresentModes)
+	{
+		if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
+			return availablePresentMode;
+	}
+
+	return VK_PRESENT_MODE_FIFO_KHR;
+}
+
+VkExtent2D PresentTarget::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
+{
+	if (capabilities.currentExtent.width != UINT32_MAX)
+		return capabilities.currentExtent;
+	else
+	{
+		VkExtent2D actualExtent = {											//    , glfwGetFramebufferSize    
+			static_cast<uint32_t>(framebufferWidth),
+			static_cast<uint32_t>(framebufferHeight)
+		};
+
+		actualExtent.width = std::max(capabilities.minImageExtent.width, std::min(capabilities.maxImageExtent.width, actualExtent.width));
+		actualExtent.height = std::max(capabilities.minImageExtent.height, std::min(capabilities.maxImageExtent.height, actualExtent.height));
+
+		return actualExtent;
+	}
+}
+
+void PresentTarget::createImageViews()
+{
+	swapChainImageViews.resize(swapChainImage.size());
+
+	for (size_t i = 0; i < swapChainImageViews.size(); i++)								//    ImageView  Image
+	{
+		VkImageViewCreateInfo createInfo{};
+		createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		createInfo.image = swapChainImage[i];
+		createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		createInfo.format = swapChainImageFormat;
+		createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
+		createInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
+		createInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
+		createInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
+		createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		createInfo.subresourceRange.baseMipLevel = 0;
+		createInfo.subresourceRange.levelCount = 1;
+		createInfo.subresourceRange.baseArrayLayer = 0;
+		createInfo.subresourceRange.layerCount = 1;
+
+		if (vkCreateImageView(device, &createInfo, nullptr, &swapChainImageViews[i]) != VK_SUCCESS)
+			throw std::runtime_error("Failed to create image views!");
+	}
+}
+
+void PresentTarget::createDepthResources()
+{
+	VkImageCreateInfo imageInfo{};
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.extent = { swapChainExtent.width, swapChainExtent.height, 1 };
+	imageInfo.mipLevels = 1;
+	imageInfo.arrayLayers = 1;
+	imageInfo.format = depthFormat;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+	if (vkCreateImage(device, &imageInfo, nullptr, &depthImage) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create depth image!");
+
+	VkMemoryRequirements memRequirements;
+	vkGetImageMemoryRequirements(device, depthImage, &memRequirements);
+
+	VulkanContext context;
+	context.physicalDevice = physicalDevice;
+	context.device = device;
+
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = memRequirements.size;
+	allocInfo.memoryTypeIndex = findMemoryType(context, memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	if (vkAllocateMemory(device, &allocInfo, nullptr, &depthImageMemory) != VK_SUCCESS)
+		throw std::runtime_error("Failed to allocate depth image memory!");
+	vkBindImageMemory(device, depthImage, depthImageMemory, 0);
+
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = depthImage;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = depthFormat;
+	viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+	viewInfo.subresourceRange.levelCount = 1;
+	viewInfo.subresourceRange.layerCount = 1;
+
+	if (vkCreateImageView(device, &viewInfo, nullptr, &depthImageView) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create depth image view!");
+}
+
+void PresentTarget::createFramebuffers(VkRenderPass renderPass, VkFormat depthFormat)
+{
+	this->depthFormat = depthFormat;
+	createDepthResources();											//     :        
+
+	swapChainFramebuffers.resize(swapChainImageViews.size());
+
+	for (size_t i = 0; i < swapChainImageViews.size(); i++) {
+		VkImageView attachments[] = {
+			swapChainImageViews[i],
+			depthImageView
+		};
+
+		VkFramebufferCreateInfo framebufferInfo{};
+		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferInfo.renderPass = renderPass;
+		framebufferInfo.attachmentCount = 2;
+		framebufferInfo.pAttachments = attachments;
+		framebufferInfo.width = swapChainExtent.width;
+		framebufferInfo.height = swapChainExtent.height;
+		framebufferInfo.layers = 1;
+
+		if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &swapChainFramebuffers[i]) != VK_SUCCESS) {
+			throw std::runtime_error("failed to create framebuffer!");
+		}
+	}
+}
+
+void PresentTarget::createCommandBuffers(VkCommandPool commandPool)
+{
+	this->commandPool = commandPool;
+	commandBuffers.resize(swapChainFramebuffers.size());
+
+	VkCommandBufferAllocateInfo allocInfo{};					//      
+	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	allocInfo.commandPool = commandPool;
+	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	allocInfo.commandBufferCount = (uint32_t)commandBuffers.size();
+
+	if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {		//  
+		throw std::runtime_error("failed to allocate command buffers!");
+	}
+}
+
+void PresentTarget::recordCommandBuffer(VkRenderPass renderPass, const std::function<void(VkCommandBuffer)>& draw)
+{
+	VkCommandBuffer commandBuffer = commandBuffers[imageIndex];		// acquireImage   ,   
+
+	VkViewport viewport{};										//      ,      
+	viewport.x = 0.0f;
+	viewport.y = 0.0f;
+	viewport.width = (float)swapChainExtent.width;
+	viewport.height = (float)swapChainExtent.height;
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+
+	VkRect2D scissor{};
+	scissor.offset = { 0, 0 };
+	scissor.extent = swapChainExtent;
+
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;	//    
+
+	if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {	//     
+		throw std::runtime_error("failed to begin recording command buffer!");
+	}
+
+	VkRenderPassBeginInfo renderPassInfo{};						//      
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassInfo.renderPass = renderPass;
+	renderPassInfo.framebuffer = swapChainFramebuffers[imageIndex];
+	renderPassInfo.renderArea.offset = { 0, 0 };
+	renderPassInfo.renderArea.extent = swapChainExtent;
+
+	VkClearValue clearValues[2]{};								//   -       
+	clearValues[0].color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+	clearValues[1].depthStencil = { 1.0f, 0 };					//   
+	renderPassInfo.clearValueCount = 2;
+	renderPassInfo.pClearValues = clearValues;
+
+	vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE); //   
+	vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+	vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+	draw(commandBuffer);										//       
+
+	vkCmdEndRenderPass(commandBuffer);	//   
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {	//    
+		throw std::runtime_error("failed to record command buffer!");
+	}
+}
+
+void PresentTarget::createSyncObjects(uint32_t framesInFlight)
+{
+	imageAvailableSemaphores.resize(framesInFlight);
+	renderFinishedSemaphores.resize(framesInFlight);
+
+	VkSemaphoreCreateInfo semaphoreInfo{};
+	semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+	for (uint32_t i = 0; i < framesInFlight; i++)
+	{
+		if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &imageAvailableSemaphores[i]) != VK_SUCCESS ||
+			vkCreateSemaphore(device, &semaphoreInfo, nullptr, &renderFinishedSemaphores[i]) != VK_SUCCESS)
+			throw std::runtime_error("Failed to create synchronization objects for a frame!");
+	}
+}
+
+void PresentTarget::recreateSwapChain(VkRenderPass renderPass)
+{
+	cleanupSwapChain();
+
+	createSwapChain(physicalDevice, device, queueFamilies[0], queueFamilies[1], swapChainImageFormat);	//  ,      
+	createImageViews();
+	createFramebuffers(renderPass, depthFormat);
+	createCommandBuffers(commandPool);
+
+	resized = false;
+}
+
+void PresentTarget::cleanupSwapChain()
+{
+	for (auto framebuffer : swapChainFramebuffers) {						//   
+		vkDestroyFramebuffer(device, framebuffer, nullptr);
+	}
+	swapChainFramebuffers.clear();
+
+	vkDestroyImageView(device, depthImageView, nullptr);					//   
+	vkDestroyImage(device, depthImage, nullptr);
+	vkFreeMemory(device, depthImageMemory, nullptr);
+	depthImageView = VK_NULL_HANDLE;
+	depthImage = VK_NULL_HANDLE;
+	depthImageMemory = VK_NULL_HANDLE;
+
+	if (!commandBuffers.empty())
+		vkFreeCommandBuffers(device, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+	commandBuffers.clear();
+
+	for (auto imageView : swapChainImageViews)								//    ImageView
+		vkDestroyImageView(device, imageView, nullptr);
+	swapChainImageViews.clear();
+
+	vkDestroySwapchainKHR(device, swapChain, nullptr);						//  swap chain
+	swapChain = VK_NULL_HANDLE;
+}
+
+void PresentTarget::cleanup(VkInstance instance)
+{
+	for (size_t i = 0; i < imageAvailableSemaphores.size(); i++)			//  
+	{
+		vkDestroySemaphore(device, renderFinishedSemaphores[i], nullptr);
+		vkDestroySemaphore(device, imageAvailableSemaphores[i], nullptr);
+	}
+
+	cleanupSwapChain();
+
+	vkDestroySurfaceKHR(instance, surface, nullptr);						//   
+
+	glfwDestroyWindow(window);												//  
+}
+
+VkResult PresentTarget::acquireImage(uint32_t frame, VkFence frameFence)
+{
+	VkResult result = vkAcquireNextImageKHR(device, swapChain, UINT64_MAX, imageAvailableSemaphores[frame], VK_NULL_HANDLE, &imageIndex);
+	if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+		return result;
+
+	if (imagesInFlight[imageIndex] != VK_NULL_HANDLE && imagesInFlight[imageIndex] != frameFence)	//     
+		vkWaitForFences(device, 1, &imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+	imagesInFlight[imageIndex] = frameFence;
+
+	return result;
+}
+
+void PresentTarget::setFramebufferSize(int width, int height)
+{
+	framebufferWidth = width;
+	framebufferHeight = height;
+	resized = true;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <GLFW/glfw3.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct SwapChainSupportDetails {									//       swap chain
+	VkSurfaceCapabilitiesKHR capabilities;							//   surface
+	std::vector<VkSurfaceFormatKHR> formats;						//  surface
+	std::vector<VkPresentModeKHR> presentModes;						//   
+};
+
+class PresentTarget													//  : surface, swap chain  ,     
+{
+private:
+	GLFWwindow* window = nullptr;									//  
+	VkSurfaceKHR surface = VK_NULL_HANDLE;							// Surface 
+	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;				//     ,    swap chain
+	VkDevice device = VK_NULL_HANDLE;
+	VkCommandPool commandPool = VK_NULL_HANDLE;
+	uint32_t queueFamilies[2] = { 0, 0 };							//      
+	VkSwapchainKHR swapChain = VK_NULL_HANDLE;						//  swap chain
+	VkFormat swapChainImageFormat = VK_FORMAT_UNDEFINED;			//    swap chain
+	VkExtent2D swapChainExtent = { 0, 0 };							//    swap chain
+	std::vector<VkImage> swapChainImage;							//   swap chain
+	std::vector<VkImageView> swapChainImageViews;					// ImageView  swap chain
+	std::vector<VkFramebuffer> swapChainFramebuffers;				// 
+	VkFormat depthFormat = VK_FORMAT_UNDEFINED;						//   ,    
+	VkImage depthImage = VK_NULL_HANDLE;							//    swap chain
+	VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
+	VkImageView depthImageView = VK_NULL_HANDLE;
+	std::vector<VkCommandBuffer> commandBuffers;					//  ,    
+	std::vector<VkSemaphore> imageAvailableSemaphores;				//   ,      
+	std::vector<VkSemaphore> renderFinishedSemaphores;				//   
+	std::vector<VkFence> imagesInFlight;							//  ,   
+	int framebufferWidth = 0;										//   ,   
+	int framebufferHeight = 0;
+	bool resized = false;											// Swap chain  
+	uint32_t imageIndex = 0;										// ,    
+
+	VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats, VkFormat requiredFormat);	//  ,    
+	VkPresentModeKHR shooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);		//     
+	VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);								//    
+	void createDepthResources();									//     swap chain
+public:
+	void createWindow(uint32_t width, uint32_t height, const std::string& title);	//  ,    
+	void createSurface(VkInstance instance);						//  surface 
+	void createSwapChain(VkPhysicalDevice physicalDevice, VkDevice device, uint32_t graphicsFamily, uint32_t presentFamily,
+		VkFormat requiredFormat = VK_FORMAT_UNDEFINED);				//  swap chain,  ,     
+	void createImageViews();										//  image view
+	void createFramebuffers(VkRenderPass renderPass, VkFormat depthFormat);	//         
+	void createCommandBuffers(VkCommandPool commandPool);			//   ,    
+	void recordCommandBuffer(VkRenderPass renderPass, const std::function<void(VkCommandBuffer)>& draw);	//      
+	void createSyncObjects(uint32_t framesInFlight);				//  
+	void recreateSwapChain(VkRenderPass renderPass);				//  swap chain,   
+	void cleanupSwapChain();										//  swap chain     
+	void cleanup(VkInstance instance);								//    
+
+	VkResult acquireImage(uint32_t frame, VkFence frameFence);		//     ,    
+	void setFramebufferSize(int width, int height);					//     
+	bool isMinimized() const { return framebufferWidth == 0 || framebufferHeight == 0; }
+	bool isResized() const { return resized; }
+	GLFWwindow* getWindow() const { return window; }
+	VkSurfaceKHR getSurface() const { return surface; }
+	VkFormat getImageFormat() const { return swapChainImageFormat; }
+	VkExtent2D getExtent() const { return swapChainExtent; }
+	size_t getImageCount() const { return swapChainImage.size(); }
+	VkSwapchainKHR getSwapChain() const { return swapChain; }
+	uint32_t getImageIndex() const { return imageIndex; }
+	VkCommandBuffer getCommandBuffer() const { return commandBuffers[imageIndex]; }
+	VkSemaphore getImageAvailableSemaphore(uint32_t frame) const { return imageAvailableSemaphores[frame]; }
+	VkSemaphore getRenderFinishedSemaphore(uint32_t frame) const { return renderFinishedSemaphores[frame]; }
+
+	static SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device, VkSurfaceKHR surface);	//    SwapChainSupportDetails
+};
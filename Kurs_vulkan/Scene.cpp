@@ -0,0 +1,252 @@
+#include "Scene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <xmmintrin.h>
+
+namespace
+{
+	const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+	template <typename T>
+	void permute(std::vector<T>& values, const std::vector<uint32_t>& order)	// values[i] = values[order[i]]
+	{
+		std::vector<T> result(values.size());
+		for (size_t i = 0; i < order.size(); i++)
+			result[i] = values[order[i]];
+		values.swap(result);
+	}
+}
+
+Scene::Scene(uint32_t frameSlots) : frameSlots(frameSlots)
+{
+	if (frameSlots == 0 || frameSlots > 8)
+		throw std::runtime_error("Scene supports from 1 to 8 frame slots!");
+}
+
+uint32_t Scene::addObject(uint32_t parent)
+{
+	uint32_t index = static_cast<uint32_t>(parents.size());
+	uint32_t parentIndex = parent == noParent ? noParent : handleToIndex.at(parent);
+
+	positionX.push_back(0.0f); positionY.push_back(0.0f); positionZ.push_back(0.0f);
+	rotationX.push_back(0.0f); rotationY.push_back(0.0f); rotationZ.push_back(0.0f); rotationW.push_back(1.0f);
+	scaleX.push_back(1.0f); scaleY.push_back(1.0f); scaleZ.push_back(1.0f);
+	parents.push_back(parentIndex);
+	depths.push_back(parentIndex == noParent ? 0 : depths[parentIndex] + 1);
+	worldMatrices.insert(worldMatrices.end(), identity, identity + 16);
+	localDirty.push_back(1);
+	worldChanged.push_back(0);
+	pendingSlots.push_back(0);
+	handleToIndex.push_back(index);
+
+	needsSort = true;
+
+	return index;
+}
+
+void Scene::setTransform(uint32_t object, const float position[3], const float rotation[4], const float scale[3])
+{
+	uint32_t i = handleToIndex[object];
+
+	positionX[i] = position[0]; positionY[i] = position[1]; positionZ[i] = position[2];
+	rotationX[i] = rotation[0]; rotationY[i] = rotation[1]; rotationZ[i] = rotation[2]; rotationW[i] = rotation[3];
+	scaleX[i] = scale[0]; scaleY[i] = scale[1]; scaleZ[i] = scale[2];
+	localDirty[i] = 1;
+}
+
+void Scene::sortByDepth()
+{
+	std::vector<uint32_t> order(parents.size());					// order[ ] =  
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+		return depths[a] < depths[b];
+	});
+
+	std::vector<uint32_t> newIndex(order.size());
+	for (size_t i = 0; i < order.size(); i++)
+		newIndex[order[i]] = static_cast<uint32_t>(i);
+
+	permute(positionX, order); permute(positionY, order); permute(positionZ, order);
+	permute(rotationX, order); permute(rotationY, order); permute(rotationZ, order); permute(rotationW, order);
+	permute(scaleX, order); permute(scaleY, order); permute(scaleZ, order);
+	permute(parents, order);
+	permute(depths, order);
+
+	for (auto& parent : parents)
+	{
+		if (parent != noParent)
+			parent = newIndex[parent];
+	}
+	for (auto& index : handleToIndex)
+		index = newIndex[index];
+
+	worldMatrices.assign(parents.size() * 16, 0.0f);
+	std::fill(localDirty.begin(), localDirty.end(), 1);			//  ,      
+	std::fill(worldChanged.begin(), worldChanged.end(), 0);
+
+	levelOffsets.clear();
+	for (size_t i = 0; i < depths.size(); i++)
+	{
+		while (levelOffsets.size() <= depths[i])
+			levelOffsets.push_back(i);
+	}
+	levelOffsets.push_back(depths.size());
+
+	needsSort = false;
+}
+
+void Scene::updateGroup(size_t begin, size_t count, uint8_t* slotData, uint8_t slotMask)
+{
+	size_t index[4];
+	bool dirty[4] = { false, false, false, false };
+	bool anyDirty = false;
+	bool hasParent = false;
+
+	for (size_t lane = 0; lane < 4; lane++)							//     
+	{
+		index[lane] = begin + std::min(lane, count - 1);
+		if (lane >= count)
+			continue;
+
+		uint32_t parent = parents[index[lane]];
+		dirty[lane] = localDirty[index[lane]] || (parent != noParent && worldChanged[parent]);
+		anyDirty |= dirty[lane];
+		hasParent |= parent != noParent;
+	}
+
+	if (anyDirty)
+	{
+		auto load = [&](const std::vector<float>& values) {
+			return count == 4 ? _mm_loadu_ps(&values[begin])
+				: _mm_setr_ps(values[index[0]], values[index[1]], values[index[2]], values[index[3]]);
+		};
+
+		__m128 qx = load(rotationX), qy = load(rotationY), qz = load(rotationZ), qw = load(rotationW);
+		__m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f);
+
+		__m128 xx = _mm_mul_ps(qx, qx), yy = _mm_mul_ps(qy, qy), zz = _mm_mul_ps(qz, qz);
+		__m128 xy = _mm_mul_ps(qx, qy), xz = _mm_mul_ps(qx, qz), yz = _mm_mul_ps(qy, qz);
+		__m128 wx = _mm_mul_ps(qw, qx), wy = _mm_mul_ps(qw, qy), wz = _mm_mul_ps(qw, qz);
+
+		__m128 local[4][3];											//  : ,  (  0 0 0 1)
+		__m128 sx = load(scaleX), sy = load(scaleY), sz = load(scaleZ);
+		local[0][0] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx);
+		local[0][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx);
+		local[0][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx);
+		local[1][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy);
+		local[1][1] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy);
+		local[1][2] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy);
+		local[2][0] = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz);
+		local[2][1] = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz);
+		local[2][2] = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz);
+		local[3][0] = load(positionX);
+		local[3][1] = load(positionY);
+		local[3][2] = load(positionZ);
+
+		__m128 world[16];											//     ,  
+		if (hasParent)
+		{
+			const float* parentMatrix[4];
+			for (size_t lane = 0; lane < 4; lane++)
+			{
+				uint32_t parent = parents[index[lane]];
+				parentMatrix[lane] = parent == noParent ? identity : &worldMatrices[size_t(parent) * 16];
+			}
+
+			__m128 parent[16];
+			for (int e = 0; e < 16; e++)
+				parent[e] = _mm_setr_ps(parentMatrix[0][e], parentMatrix[1][e], parentMatrix[2][e], parentMatrix[3][e]);
+
+			for (int column = 0; column < 4; column++)				// world = parent * local
+			{
+				for (int row = 0; row < 4; row++)
+				{
+					__m128 sum = column == 3 ? parent[12 + row] : _mm_setzero_ps();
+					for (int k = 0; k < 3; k++)
+						sum = _mm_add_ps(sum, _mm_mul_ps(parent[k * 4 + row], local[column][k]));
+					world[column * 4 + row] = sum;
+				}
+			}
+		}
+		else
+		{
+			for (int column = 0; column < 4; column++)
+			{
+				for (int row = 0; row < 3; row++)
+					world[column * 4 + row] = local[column][row];
+				world[column * 4 + 3] = column == 3 ? one : _mm_setzero_ps();
+			}
+		}
+
+		for (int column = 0; column < 4; column++)					//     
+		{
+			__m128 r0 = world[column * 4], r1 = world[column * 4 + 1], r2 = world[column * 4 + 2], r3 = world[column * 4 + 3];
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			__m128 lanes[4] = { r0, r1, r2, r3 };
+			for (size_t lane = 0; lane < count; lane++)
+			{
+				if (dirty[lane])
+					_mm_storeu_ps(&worldMatrices[index[lane] * 16 + column * 4], lanes[lane]);
+			}
+		}
+	}
+
+	uint8_t allSlots = static_cast<uint8_t>((1u << frameSlots) - 1);
+	for (size_t lane = 0; lane < count; lane++)
+	{
+		size_t i = index[lane];
+		worldChanged[i] = dirty[lane];
+		localDirty[i] = 0;
+		if (dirty[lane])
+			pendingSlots[i] = allSlots;								//        
+
+		if (slotData != nullptr && (pendingSlots[i] & slotMask))	//    
+		{
+			memcpy(slotData + i * 16 * sizeof(float), &worldMatrices[i * 16], 16 * sizeof(float));
+			pendingSlots[i] &= ~slotMask;
+			uploadedMatrices.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
+
+void Scene::update(TaskPool& pool, void* mappedSlot, uint32_t slot)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	if (needsSort)
+		sortByDepth();
+
+	uint8_t* slotData = static_cast<uint8_t*>(mappedSlot);
+	uint8_t slotMask = static_cast<uint8_t>(1u << slot);
+
+	for (size_t level = 0; level + 1 < levelOffsets.size(); level++)	//    ,   - 
+	{
+		size_t levelBegin = levelOffsets[level];
+		size_t levelSize = levelOffsets[level + 1] - levelBegin;
+		size_t groupCount = (levelSize + 3) / 4;
+
+		pool.parallelFor(groupCount, 64, [&](size_t first, size_t last) {
+			for (size_t group = first; group < last; group++)
+			{
+				size_t begin = levelBegin + group * 4;
+				updateGroup(begin, std::min<size_t>(4, levelBegin + levelSize - begin), slotData, slotMask);
+			}
+		});
+	}
+
+	lastUpdateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	totalUpdateMs += lastUpdateMs;
+	updateCount++;
+}
+
+void Scene::printStats(size_t threadCount) const
+{
+	std::cout << "Scene: " << parents.size() << " objects, " << (levelOffsets.empty() ? 0 : levelOffsets.size() - 1) << " levels, "
+		<< threadCount << " threads, transform update " << (updateCount ? totalUpdateMs / updateCount : 0.0) << " ms average, "
+		<< lastUpdateMs << " ms last, " << uploadedMatrices.load() << " matrices uploaded" << std::endl;
+}
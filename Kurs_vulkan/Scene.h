@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "TaskPool.h"
+
+class Scene															//      ,   
+{
+private:
+	std::vector<float> positionX, positionY, positionZ;				//  
+	std::vector<float> rotationX, rotationY, rotationZ, rotationW;	//   ()
+	std::vector<float> scaleX, scaleY, scaleZ;						//  
+	std::vector<uint32_t> parents;									//     
+	std::vector<uint32_t> depths;									//    
+	std::vector<float> worldMatrices;								//  , 16 float  ,  
+	std::vector<uint8_t> localDirty;								//   
+	std::vector<uint8_t> worldChanged;								//      
+	std::vector<uint8_t> pendingSlots;								//    ,      
+	std::vector<uint32_t> handleToIndex;							//      
+	std::vector<size_t> levelOffsets;								//     
+	bool needsSort = false;											//  ,    
+	uint32_t frameSlots;											//     
+	double lastUpdateMs = 0.0;										//   
+	double totalUpdateMs = 0.0;										//   
+	uint64_t updateCount = 0;										//  
+	std::atomic<uint64_t> uploadedMatrices{ 0 };					//      
+
+	void sortByDepth();												//         
+	void updateGroup(size_t begin, size_t count, uint8_t* slotData, uint8_t slotMask);	// SIMD   4    
+public:
+	static const uint32_t noParent = ~0u;							//   
+
+	explicit Scene(uint32_t frameSlots);
+
+	uint32_t addObject(uint32_t parent = noParent);					//  ,     
+	void setTransform(uint32_t object, const float position[3], const float rotation[4], const float scale[3]);	//   
+	void update(TaskPool& pool, void* mappedSlot, uint32_t slot);	//         slot  
+	uint32_t getInstanceIndex(uint32_t object) const { return handleToIndex[object]; }	//       
+	const float* getWorldMatrix(uint32_t object) const { return &worldMatrices[size_t(handleToIndex[object]) * 16]; }
+	size_t getObjectCount() const { return parents.size(); }
+	static size_t getSlotSize(size_t objectCount) { return objectCount * 16 * sizeof(float); }	//     
+	void printStats(size_t threadCount) const;						//    
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+template <typename T, size_t Capacity>
+class SpscQueue														//         
+{
+	static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+private:
+	T items[Capacity];												//   
+	alignas(64) std::atomic<size_t> head{ 0 };						//  ,   
+	alignas(64) std::atomic<size_t> tail{ 0 };						//  ,   
+public:
+	bool tryPush(const T& item)										//     , false   
+	{
+		size_t currentTail = tail.load(std::memory_order_relaxed);
+		if (currentTail - head.load(std::memory_order_acquire) == Capacity)
+			return false;
+
+		items[currentTail & (Capacity - 1)] = item;
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool tryPop(T& item)											//     , false   
+	{
+		size_t currentHead = head.load(std::memory_order_relaxed);
+		if (currentHead == tail.load(std::memory_order_acquire))
+			return false;
+
+		item = items[currentHead & (Capacity - 1)];
+		head.store(currentHead + 1, std::memory_order_release);
+		return true;
+	}
+};
@@ -0,0 +1,178 @@
+#include "StartupGraph.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+uint32_t StartupGraph::addNode(const std::string& name, std::function<void()> work, const std::vector<uint32_t>& dependencies, bool mainThread)
+{
+	uint32_t index = static_cast<uint32_t>(nodes.size());
+
+	Node node;
+	node.name = name;
+	node.work = std::move(work);
+	node.dependencies = dependencies;
+	node.pendingDependencies = static_cast<uint32_t>(dependencies.size());
+	node.mainThread = mainThread;
+
+	for (uint32_t dependency : dependencies)
+	{
+		if (dependency >= index)
+			throw std::runtime_error("Startup node depends on a node that is not added yet!");
+		nodes[dependency].dependents.push_back(index);
+	}
+
+	nodes.push_back(std::move(node));
+
+	return index;
+}
+
+void StartupGraph::schedule(uint32_t node)
+{
+	inFlight++;
+
+	if (nodes[node].mainThread)
+		mainThreadReady.push_back(node);
+	else
+		pool->submit([this, node] { execute(node); });
+}
+
+void StartupGraph::execute(uint32_t node)
+{
+	auto nodeStart = std::chrono::steady_clock::now();
+	std::exception_ptr nodeError;
+
+	try
+	{
+		nodes[node].work();
+	}
+	catch (...)
+	{
+		nodeError = std::current_exception();
+	}
+
+	auto nodeEnd = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		nodes[node].startMs = std::chrono::duration<double, std::milli>(nodeStart - start).count();
+		nodes[node].durationMs = std::chrono::duration<double, std::milli>(nodeEnd - nodeStart).count();
+		inFlight--;
+		finishedCount++;
+
+		if (nodeError && !error)
+			error = std::move(nodeError);
+
+		if (!error)
+		{
+			for (uint32_t dependent : nodes[node].dependents)
+			{
+				if (--nodes[dependent].pendingDependencies == 0)
+					schedule(dependent);
+			}
+		}
+
+		condition.notify_all();										//  mutex:    run     
+	}
+}
+
+void StartupGraph::run(TaskPool& taskPool)
+{
+	pool = &taskPool;
+	start = std::chrono::steady_clock::now();
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	for (uint32_t i = 0; i < nodes.size(); i++)
+	{
+		if (nodes[i].pendingDependencies == 0)
+			schedule(i);
+	}
+
+	for (;;)
+	{
+		condition.wait(lock, [this] { return !mainThreadReady.empty() || inFlight == 0; });
+
+		if (!mainThreadReady.empty())
+		{
+			uint32_t node = mainThreadReady.front();
+			mainThreadReady.pop_front();
+
+			if (error)													//         
+			{
+				inFlight--;
+				continue;
+			}
+
+			lock.unlock();
+			execute(node);
+			lock.lock();
+			continue;
+		}
+
+		break;														//        
+	}
+
+	totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	pool = nullptr;
+
+	if (error)
+		std::rethrow_exception(error);
+
+	if (finishedCount != nodes.size())
+		throw std::runtime_error("Startup graph has a dependency cycle!");
+}
+
+void StartupGraph::printStats() const
+{
+	std::vector<uint32_t> order(nodes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+		return nodes[a].startMs < nodes[b].startMs;
+	});
+
+	double sumMs = 0.0;
+	auto precision = std::cout.precision();
+	std::cout << "Startup: " << nodes.size() << " nodes, " << totalMs << " ms total" << std::endl;
+	for (uint32_t i : order)
+	{
+		const Node& node = nodes[i];
+		sumMs += node.durationMs;
+		std::cout << "  " << std::left << std::setw(20) << node.name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(9) << node.startMs << " ms +" << std::setw(9) << node.durationMs << " ms"
+			<< (node.mainThread ? "  main thread" : "") << std::endl;
+	}
+	std::cout.unsetf(std::ios::floatfield);
+	std::cout.precision(precision);
+
+	std::vector<uint32_t> path;										//  :        
+	auto finish = [this](uint32_t i) { return nodes[i].startMs + nodes[i].durationMs; };
+	if (!nodes.empty())
+	{
+		uint32_t node = order.front();
+		for (uint32_t i = 0; i < nodes.size(); i++)
+		{
+			if (finish(i) > finish(node))
+				node = i;
+		}
+
+		for (;;)
+		{
+			path.push_back(node);
+			if (nodes[node].dependencies.empty())
+				break;
+			node = *std::max_element(nodes[node].dependencies.begin(), nodes[node].dependencies.end(), [&](uint32_t a, uint32_t b) {
+				return finish(a) < finish(b);
+			});
+		}
+	}
+
+	std::cout << "  critical path:";
+	for (auto it = path.rbegin(); it != path.rend(); ++it)
+		std::cout << (it == path.rbegin() ? " " : " -> ") << nodes[*it].name;
+	std::cout << std::endl;
+	std::cout << "  sum of node times " << sumMs << " ms, parallel speedup " << (totalMs > 0.0 ? sumMs / totalMs : 0.0) << std::endl;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "TaskPool.h"
+
+class StartupGraph													//         
+{
+private:
+	struct Node														//  
+	{
+		std::string name;											//    
+		std::function<void()> work;									//  
+		std::vector<uint32_t> dependencies;							// ,    
+		std::vector<uint32_t> dependents;							// ,  
+		uint32_t pendingDependencies = 0;							//   
+		bool mainThread = false;									//      
+		double startMs = 0.0;										//    
+		double durationMs = 0.0;									//  
+	};
+
+	std::vector<Node> nodes;										//    
+	TaskPool* pool = nullptr;										// ,    ,   run
+	std::mutex mutex;												//      
+	std::condition_variable condition;								//   
+	std::deque<uint32_t> mainThreadReady;							//    
+	size_t inFlight = 0;											// ,    
+	size_t finishedCount = 0;										//  
+	std::exception_ptr error;										//  ,      
+	std::chrono::steady_clock::time_point start;					//   
+	double totalMs = 0.0;											//    
+
+	void schedule(uint32_t node);									//   ,   mutex
+	void execute(uint32_t node);									//       
+public:
+	uint32_t addNode(const std::string& name, std::function<void()> work, const std::vector<uint32_t>& dependencies = {}, bool mainThread = false);	//  ,     
+	void run(TaskPool& taskPool);									//   ,    
+	void printStats() const;										//      
+};
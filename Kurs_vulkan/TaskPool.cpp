@@ -0,0 +1,127 @@
+#include "TaskPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+TaskPool::TaskPool(size_t threadCount)
+{
+	for (size_t i = 0; i < threadCount; i++)
+		workers.emplace_back(&TaskPool::workerLoop, this);
+}
+
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+
+	for (auto& worker : workers)									//      
+		worker.join();
+}
+
+void TaskPool::workerLoop()
+{
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty())
+				return;
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
+
+bool TaskPool::runPendingTask()
+{
+	std::function<void()> task;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (tasks.empty())
+			return false;
+		task = std::move(tasks.front());
+		tasks.pop_front();
+	}
+	task();
+
+	return true;
+}
+
+void TaskPool::submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	condition.notify_one();
+}
+
+void TaskPool::parallelFor(size_t count, size_t minBatch, const std::function<void(size_t, size_t)>& body)
+{
+	if (count == 0)
+		return;
+
+	size_t batch = std::max(minBatch, (count + getThreadCount() - 1) / getThreadCount());	//      
+	size_t batchCount = (count + batch - 1) / batch;
+	if (batchCount == 1)
+	{
+		body(0, count);
+		return;
+	}
+
+	struct BatchState												//   , ,    
+	{
+		std::atomic<size_t> remaining{ 0 };
+		std::mutex mutex;
+		std::exception_ptr error;									//     
+	};
+	auto state = std::make_shared<BatchState>();
+	state->remaining = batchCount - 1;
+	for (size_t i = 1; i < batchCount; i++)
+	{
+		size_t begin = i * batch;
+		size_t end = std::min(count, begin + batch);
+		submit([&body, begin, end, state] {
+			try
+			{
+				body(begin, end);
+			}
+			catch (...)												//      ,  std::terminate
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				if (!state->error)
+					state->error = std::current_exception();
+			}
+			state->remaining.fetch_sub(1, std::memory_order_release);
+		});
+	}
+
+	std::exception_ptr callerError;
+	try
+	{
+		body(0, std::min(count, batch));							//     
+	}
+	catch (...)														//     body,   
+	{
+		callerError = std::current_exception();
+	}
+
+	while (state->remaining.load(std::memory_order_acquire) != 0)	//    ,   
+	{
+		if (!runPendingTask())
+			std::this_thread::yield();
+	}
+
+	if (callerError)
+		std::rethrow_exception(callerError);
+	if (state->error)												//      
+		std::rethrow_exception(state->error);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskPool														//   
+{
+private:
+	std::vector<std::thread> workers;								//  
+	std::deque<std::function<void()>> tasks;						//  
+	std::mutex mutex;												//   
+	std::condition_variable condition;								//    
+	bool stopping = false;											//    
+
+	void workerLoop();												//   
+	bool runPendingTask();											//        
+public:
+	explicit TaskPool(size_t threadCount = std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1);
+	~TaskPool();
+
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	void submit(std::function<void()> task);						//    
+	void parallelFor(size_t count, size_t minBatch, const std::function<void(size_t, size_t)>& body);	//    [0, count) ,    
+	size_t getThreadCount() const { return workers.size() + 1; }	//     
+};
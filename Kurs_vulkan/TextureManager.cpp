@@ -0,0 +1,679 @@
+#include "TextureManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <numeric>
+#include <set>
+
+namespace
+{
+	struct FormatBlock															//  :     ,     -  
+	{
+		uint32_t bytes;
+		uint32_t width;
+		uint32_t height;
+	};
+
+	FormatBlock formatBlock(VkFormat format)									// bytes = 0   
+	{
+		static const struct { VkFormat first; VkFormat last; uint32_t bytes; } uncompressed[] = {
+			{ VK_FORMAT_R4G4_UNORM_PACK8, VK_FORMAT_R4G4_UNORM_PACK8, 1 },
+			{ VK_FORMAT_R4G4B4A4_UNORM_PACK16, VK_FORMAT_A1R5G5B5_UNORM_PACK16, 2 },
+			{ VK_FORMAT_R8_UNORM, VK_FORMAT_R8_SRGB, 1 },
+			{ VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8_SRGB, 2 },
+			{ VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_B8G8R8_SRGB, 3 },
+			{ VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_A2B10G10R10_SINT_PACK32, 4 },	// RGBA8, BGRA8, ABGR8  10- 
+			{ VK_FORMAT_R16_UNORM, VK_FORMAT_R16_SFLOAT, 2 },
+			{ VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16_SFLOAT, 4 },
+			{ VK_FORMAT_R16G16B16_UNORM, VK_FORMAT_R16G16B16_SFLOAT, 6 },
+			{ VK_FORMAT_R16G16B16A16_UNORM, VK_FORMAT_R16G16B16A16_SFLOAT, 8 },
+			{ VK_FORMAT_R32_UINT, VK_FORMAT_R32_SFLOAT, 4 },
+			{ VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32_SFLOAT, 8 },
+			{ VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32_SFLOAT, 12 },
+			{ VK_FORMAT_R32G32B32A32_UINT, VK_FORMAT_R32G32B32A32_SFLOAT, 16 },
+			{ VK_FORMAT_B10G11R11_UFLOAT_PACK32, VK_FORMAT_E5B9G9R9_UFLOAT_PACK32, 4 },
+		};
+		static const uint32_t astcBlocks[14][2] = {								//   ASTC   VkFormat,   UNORM  SRGB
+			{ 4, 4 }, { 5, 4 }, { 5, 5 }, { 6, 5 }, { 6, 6 }, { 8, 5 }, { 8, 6 },
+			{ 8, 8 }, { 10, 5 }, { 10, 6 }, { 10, 8 }, { 10, 10 }, { 12, 10 }, { 12, 12 } };
+
+		for (const auto& range : uncompressed)
+		{
+			if (format >= range.first && format <= range.last)
+				return { range.bytes, 1, 1 };
+		}
+		if (format >= VK_FORMAT_BC1_RGB_UNORM_BLOCK && format <= VK_FORMAT_BC1_RGBA_SRGB_BLOCK)
+			return { 8, 4, 4 };
+		if (format >= VK_FORMAT_BC4_UNORM_BLOCK && format <= VK_FORMAT_BC4_SNORM_BLOCK)
+			return { 8, 4, 4 };
+		if (format > VK_FORMAT_BC1_RGBA_SRGB_BLOCK && format <= VK_FORMAT_BC7_SRGB_BLOCK)	// BC2, BC3, BC5, BC6H, BC7
+			return { 16, 4, 4 };
+		if (format >= VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK && format <= VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK)
+			return { 8, 4, 4 };
+		if (format == VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK || format == VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK)
+			return { 16, 4, 4 };
+		if (format == VK_FORMAT_EAC_R11_UNORM_BLOCK || format == VK_FORMAT_EAC_R11_SNORM_BLOCK)
+			return { 8, 4, 4 };
+		if (format == VK_FORMAT_EAC_R11G11_UNORM_BLOCK || format == VK_FORMAT_EAC_R11G11_SNORM_BLOCK)
+			return { 16, 4, 4 };
+		if (format >= VK_FORMAT_ASTC_4x4_UNORM_BLOCK && format <= VK_FORMAT_ASTC_12x12_SRGB_BLOCK)	//  ASTC  128 
+		{
+			const uint32_t* extent = astcBlocks[(format - VK_FORMAT_ASTC_4x4_UNORM_BLOCK) / 2];
+			return { 16, extent[0], extent[1] };
+		}
+		return { 0, 1, 1 };
+	}
+}
+
+TextureManager::TextureManager(VkDeviceSize residencyBudget) : residencyBudget(residencyBudget)
+{
+}
+
+void TextureManager::init(const VulkanContext& context, uint32_t framesInFlight)
+{
+	this->context = context;
+	this->framesInFlight = framesInFlight;
+	vkGetPhysicalDeviceFeatures(context.physicalDevice, &deviceFeatures);		//    
+
+	VkFenceCreateInfo fenceInfo{};
+	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+	if (vkCreateFence(context.device, &fenceInfo, nullptr, &streamFence) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create texture streaming fence!");
+}
+
+void TextureManager::cleanup()
+{
+	if (!streamUploads.empty())													//    
+	{
+		vkWaitForFences(context.device, 1, &streamFence, VK_TRUE, UINT64_MAX);
+		finishStream(0);
+	}
+	for (const auto& retired : retiredImages)									//  ,    
+	{
+		vkDestroyImageView(context.device, retired.view, nullptr);
+		vkDestroyImage(context.device, retired.image, nullptr);
+		vkFreeMemory(context.device, retired.memory, nullptr);
+	}
+	retiredImages.clear();
+	vkDestroyFence(context.device, streamFence, nullptr);
+	streamFence = VK_NULL_HANDLE;
+
+	for (auto& texture : textures)
+	{
+		vkDestroyImageView(context.device, texture.imageView, nullptr);
+		vkDestroyImage(context.device, texture.image, nullptr);
+		vkFreeMemory(context.device, texture.memory, nullptr);
+	}
+	textures.clear();
+	allocatedBytes = 0;
+	residentBytes = 0;
+}
+
+std::vector<std::string> TextureManager::candidateFiles(const std::string& name)
+{
+	std::vector<std::string> files;
+
+	if (deviceFeatures.textureCompressionBC)									// Desktop  - BCn
+		files.push_back(name + ".bc.ktx2");
+	if (deviceFeatures.textureCompressionASTC_LDR)								//   - ASTC,  ETC2
+		files.push_back(name + ".astc.ktx2");
+	if (deviceFeatures.textureCompressionETC2)
+		files.push_back(name + ".etc2.ktx2");
+	files.push_back(name + ".ktx2");											//    
+
+	return files;
+}
+
+bool TextureManager::isFormatSupported(VkFormat format)
+{
+	VkFormatProperties properties;
+	vkGetPhysicalDeviceFormatProperties(context.physicalDevice, format, &properties);
+
+	VkFormatFeatureFlags required = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+	return (properties.optimalTilingFeatures & required) == required;
+}
+
+void TextureManager::parseKtx2(Texture& texture)
+{
+	static const uint8_t identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+	const uint8_t* data = texture.file.data();
+	size_t size = texture.file.size();
+
+	if (size < 80 || memcmp(data, identifier, sizeof(identifier)) != 0)		//  KTX2  80 
+		throw std::runtime_error("Texture " + texture.name + " is not a KTX2 file!");
+
+	uint32_t header[9];															// vkFormat, typeSize, , , , , 
+	memcpy(header, data + 12, sizeof(header));
+
+	uint32_t pixelWidth = header[2];
+	uint32_t pixelHeight = header[3];
+	uint32_t levelCount = std::max(header[7], 1u);
+
+	if (header[0] == VK_FORMAT_UNDEFINED || header[8] != 0)
+		throw std::runtime_error("Texture " + texture.name + " uses supercompression, which is not supported!");
+	if (pixelWidth == 0 || pixelHeight == 0 || header[4] > 1 || header[5] > 1 || header[6] != 1)	//  0   
+		throw std::runtime_error("Texture " + texture.name + " is not a 2D texture!");
+	if (size < 80 + levelCount * 24ull)
+		throw std::runtime_error("Texture " + texture.name + " has a truncated level index!");
+
+	texture.format = static_cast<VkFormat>(header[0]);
+	FormatBlock block = formatBlock(texture.format);
+	if (block.bytes == 0)
+		throw std::runtime_error("Texture " + texture.name + " has an unsupported format!");
+	texture.blockSize = block.bytes;
+	texture.levels.resize(levelCount);
+
+	for (uint32_t i = 0; i < levelCount; i++)									//  : , ,  
+	{
+		uint64_t entry[3];
+		memcpy(entry, data + 80 + i * 24, sizeof(entry));
+
+		if (entry[0] > size || entry[1] > size - entry[0])						//      
+			throw std::runtime_error("Texture " + texture.name + " has a level outside of the file!");
+
+		MipLevel& level = texture.levels[i];
+		level.byteOffset = entry[0];
+		level.byteLength = entry[1];
+		level.width = std::max(pixelWidth >> i, 1u);
+		level.height = std::max(pixelHeight >> i, 1u);
+
+		uint64_t required = uint64_t((level.width + block.width - 1) / block.width) * ((level.height + block.height - 1) / block.height)
+			* block.bytes;														//       
+		if (level.byteLength < required)
+			throw std::runtime_error("Texture " + texture.name + " has a level smaller than its format requires!");
+	}
+
+	texture.residentLevel = levelCount;
+}
+
+VkImage TextureManager::createImage(const Texture& texture, uint32_t firstLevel, VkMemoryRequirements& requirements)
+{
+	VkImageCreateInfo imageInfo{};												//     -
+	imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageInfo.imageType = VK_IMAGE_TYPE_2D;
+	imageInfo.extent.width = texture.levels[firstLevel].width;
+	imageInfo.extent.height = texture.levels[firstLevel].height;
+	imageInfo.extent.depth = 1;
+	imageInfo.mipLevels = static_cast<uint32_t>(texture.levels.size()) - firstLevel;
+	imageInfo.arrayLayers = 1;
+	imageInfo.format = texture.format;
+	imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;	//     
+	imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+	imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+	VkImage image;
+	if (vkCreateImage(context.device, &imageInfo, nullptr, &image) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create texture image!");
+
+	vkGetImageMemoryRequirements(context.device, image, &requirements);
+	return image;
+}
+
+VkDeviceMemory TextureManager::allocateImageMemory(VkImage image, const VkMemoryRequirements& requirements)
+{
+	VkMemoryAllocateInfo allocInfo{};
+	allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	allocInfo.allocationSize = requirements.size;
+	allocInfo.memoryTypeIndex = findMemoryType(context, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	VkDeviceMemory memory;
+	if (vkAllocateMemory(context.device, &allocInfo, nullptr, &memory) != VK_SUCCESS)
+		throw std::runtime_error("Failed to allocate texture memory!");
+
+	vkBindImageMemory(context.device, image, memory, 0);
+	return memory;
+}
+
+VkDeviceSize TextureManager::layoutLevels(const Texture& texture, uint32_t firstLevel, uint32_t lastLevel, VkDeviceSize stagingSize,
+	std::vector<VkDeviceSize>& offsets)
+{
+	VkDeviceSize alignment = std::lcm(VkDeviceSize(texture.blockSize), VkDeviceSize(4));	// bufferOffset     4
+	for (uint32_t level = firstLevel; level < lastLevel; level++)
+	{
+		VkDeviceSize offset = (stagingSize + alignment - 1) / alignment * alignment;
+		offsets.push_back(offset);
+		stagingSize = offset + texture.levels[level].byteLength;
+	}
+
+	return stagingSize;
+}
+
+void TextureManager::recordUpload(VkCommandBuffer commandBuffer, const Texture& texture, VkImage image, uint32_t baseLevel, uint32_t firstLevel,
+	uint32_t lastLevel, void* mapped, VkBuffer stagingBuffer, const VkDeviceSize* offsets)
+{
+	for (uint32_t level = firstLevel; level < lastLevel; level++)				//     
+	{
+		const MipLevel& mip = texture.levels[level];
+		memcpy(static_cast<uint8_t*>(mapped) + offsets[level - firstLevel], texture.file.data() + mip.byteOffset, mip.byteLength);
+	}
+
+	VkImageMemoryBarrier barrier{};												//      layout  
+	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barrier.srcAccessMask = 0;
+	barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	barrier.image = image;
+	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	barrier.subresourceRange.baseMipLevel = firstLevel - baseLevel;
+	barrier.subresourceRange.levelCount = lastLevel - firstLevel;
+	barrier.subresourceRange.baseArrayLayer = 0;
+	barrier.subresourceRange.layerCount = 1;
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+	std::vector<VkBufferImageCopy> regions;
+	for (uint32_t level = firstLevel; level < lastLevel; level++)
+	{
+		VkBufferImageCopy region{};
+		region.bufferOffset = offsets[level - firstLevel];
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = level - baseLevel;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent = { texture.levels[level].width, texture.levels[level].height, 1 };
+		regions.push_back(region);
+	}
+	vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		static_cast<uint32_t>(regions.size()), regions.data());
+
+	barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;					//       
+	barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void TextureManager::recordCopyResident(VkCommandBuffer commandBuffer, const Texture& texture, VkImage image, uint32_t baseLevel,
+	uint32_t firstLevel)
+{
+	uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+
+	VkImageMemoryBarrier barriers[2]{};											//    ,   
+	for (auto& barrier : barriers)
+	{
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.levelCount = levelCount - firstLevel;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+	}
+	barriers[0].image = image;
+	barriers[0].subresourceRange.baseMipLevel = firstLevel - baseLevel;
+	barriers[0].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+	barriers[0].srcAccessMask = 0;
+	barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barriers[1].image = texture.image;
+	barriers[1].subresourceRange.baseMipLevel = firstLevel - texture.residentLevel;
+	barriers[1].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;			//    ,    
+	barriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	barriers[1].srcAccessMask = 0;
+	barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		0, 0, nullptr, 0, nullptr, 2, barriers);
+
+	std::vector<VkImageCopy> regions;
+	for (uint32_t level = firstLevel; level < levelCount; level++)
+	{
+		VkImageCopy region{};
+		region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.srcSubresource.mipLevel = level - texture.residentLevel;
+		region.srcSubresource.baseArrayLayer = 0;
+		region.srcSubresource.layerCount = 1;
+		region.dstSubresource = region.srcSubresource;
+		region.dstSubresource.mipLevel = level - baseLevel;
+		region.extent = { texture.levels[level].width, texture.levels[level].height, 1 };
+		regions.push_back(region);
+	}
+	vkCmdCopyImage(commandBuffer, texture.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		static_cast<uint32_t>(regions.size()), regions.data());
+
+	barriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;				//     :  -   view
+	barriers[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barriers[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+	barriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+	barriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+	barriers[1].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	barriers[1].srcAccessMask = 0;
+	barriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+	vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+		0, 0, nullptr, 0, nullptr, 2, barriers);
+}
+
+void TextureManager::uploadLevels(Texture& texture, uint32_t firstLevel, uint32_t lastLevel)
+{
+	std::vector<VkDeviceSize> offsets;											//     
+	VkDeviceSize stagingSize = layoutLevels(texture, firstLevel, lastLevel, 0, offsets);
+
+	VkBuffer stagingBuffer;
+	VkDeviceMemory stagingBufferMemory;
+	createBuffer(context, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingBuffer, stagingBufferMemory);
+
+	void* mapped;
+	vkMapMemory(context.device, stagingBufferMemory, 0, stagingSize, 0, &mapped);
+
+	VkCommandBuffer commandBuffer = beginSingleTimeCommands(context);
+	recordUpload(commandBuffer, texture, texture.image, texture.residentLevel, firstLevel, lastLevel, mapped, stagingBuffer, offsets.data());
+	endSingleTimeCommands(context, commandBuffer);								//    ,   
+
+	vkUnmapMemory(context.device, stagingBufferMemory);
+	vkDestroyBuffer(context.device, stagingBuffer, nullptr);
+	vkFreeMemory(context.device, stagingBufferMemory, nullptr);
+
+	for (uint32_t level = firstLevel; level < lastLevel; level++)
+	{
+		texture.residentBytes += texture.levels[level].byteLength;
+		residentBytes += texture.levels[level].byteLength;
+	}
+}
+
+void TextureManager::createImageView(Texture& texture)
+{
+	VkImageViewCreateInfo viewInfo{};
+	viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	viewInfo.image = texture.image;
+	viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	viewInfo.format = texture.format;
+	viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	viewInfo.subresourceRange.baseMipLevel = 0;									//     
+	viewInfo.subresourceRange.levelCount = static_cast<uint32_t>(texture.levels.size()) - texture.residentLevel;
+	viewInfo.subresourceRange.baseArrayLayer = 0;
+	viewInfo.subresourceRange.layerCount = 1;
+
+	if (vkCreateImageView(context.device, &viewInfo, nullptr, &texture.imageView) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create texture image view!");
+}
+
+void TextureManager::releaseImages(uint64_t frame)
+{
+	auto released = std::remove_if(retiredImages.begin(), retiredImages.end(), [&](const RetiredImage& retired) {
+		if (frame < retired.frame + framesInFlight)								//   retired.frame   
+			return false;
+		vkDestroyImageView(context.device, retired.view, nullptr);
+		vkDestroyImage(context.device, retired.image, nullptr);
+		vkFreeMemory(context.device, retired.memory, nullptr);
+		return true;
+	});
+	retiredImages.erase(released, retiredImages.end());
+}
+
+void TextureManager::finishStream(uint64_t frame)
+{
+	for (const auto& upload : streamUploads)									//  ,     
+	{
+		Texture& texture = textures[upload.texture];
+		retiredImages.push_back({ texture.imageView, texture.image, texture.memory, frame });	//       
+
+		texture.image = upload.image;
+		texture.memory = upload.memory;
+		texture.allocatedBytes = upload.allocatedBytes;
+		texture.residentLevel = upload.level;
+		texture.residentBytes = 0;
+		for (uint32_t level = upload.level; level < texture.levels.size(); level++)
+			texture.residentBytes += texture.levels[level].byteLength;
+		createImageView(texture);
+	}
+	streamUploads.clear();
+
+	vkFreeCommandBuffers(context.device, context.commandPool, 1, &streamCommandBuffer);
+	if (streamStagingMemory != VK_NULL_HANDLE)
+		vkUnmapMemory(context.device, streamStagingMemory);
+	vkDestroyBuffer(context.device, streamStagingBuffer, nullptr);
+	vkFreeMemory(context.device, streamStagingMemory, nullptr);
+	streamCommandBuffer = VK_NULL_HANDLE;
+	streamStagingBuffer = VK_NULL_HANDLE;
+	streamStagingMemory = VK_NULL_HANDLE;
+
+	vkResetFences(context.device, 1, &streamFence);
+}
+
+uint32_t TextureManager::loadTexture(const std::string& name)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	Texture texture;
+	texture.name = name;
+
+	std::string errors;															//     
+	for (const auto& filename : candidateFiles(name))							//      
+	{
+		if (!MappedFile::exists(filename))
+			continue;
+
+		try																		//      
+		{
+			texture.file = MappedFile(filename);
+			parseKtx2(texture);
+			if (isFormatSupported(texture.format))
+				break;
+			errors += " " + filename + ": format is not supported;";
+		}
+		catch (const std::exception& e)
+		{
+			errors += " " + filename + ": " + e.what();
+		}
+
+		texture.file = MappedFile();
+	}
+
+	if (!texture.file.isOpen())
+		throw std::runtime_error("Failed to find a supported format for texture " + name + "!" + errors);
+
+	uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+	uint32_t tailLevel = levelCount - 1;										//     
+	while (tailLevel > 0 && std::max(texture.levels[tailLevel - 1].width, texture.levels[tailLevel - 1].height) <= tailSize)
+		tailLevel--;
+
+	VkMemoryRequirements requirements;											//      
+	texture.residentLevel = tailLevel;
+	texture.tailLevel = tailLevel;
+	texture.image = createImage(texture, tailLevel, requirements);
+	texture.memory = allocateImageMemory(texture.image, requirements);
+	texture.allocatedBytes = requirements.size;
+	allocatedBytes += requirements.size;
+
+	uploadLevels(texture, tailLevel, levelCount);
+	createImageView(texture);
+	texture.requestedLevel = tailLevel;											//      requestLevel
+
+	texture.loadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	textures.push_back(std::move(texture));
+
+	return static_cast<uint32_t>(textures.size() - 1);
+}
+
+void TextureManager::loadDirectory(const std::string& directory)
+{
+	namespace fs = std::filesystem;
+
+	if (!fs::is_directory(directory))
+		return;
+
+	std::set<std::string> names;												//     
+	for (const auto& entry : fs::directory_iterator(directory))
+	{
+		std::string filename = entry.path().filename().string();
+		if (filename.size() <= 5 || filename.compare(filename.size() - 5, 5, ".ktx2") != 0)
+			continue;
+
+		std::string name = filename.substr(0, filename.size() - 5);
+		for (const char* suffix : { ".bc", ".astc", ".etc2" })
+		{
+			size_t length = strlen(suffix);
+			if (name.size() > length && name.compare(name.size() - length, length, suffix) == 0)
+			{
+				name.resize(name.size() - length);
+				break;
+			}
+		}
+		names.insert((fs::path(directory) / name).string());
+	}
+
+	for (const auto& name : names)
+		loadTexture(name);
+}
+
+uint32_t TextureManager::findTexture(const std::string& name) const
+{
+	for (uint32_t i = 0; i < textures.size(); i++)
+	{
+		if (std::filesystem::path(textures[i].name).filename().string() == name)
+			return i;
+	}
+	return UINT32_MAX;
+}
+
+uint32_t TextureManager::levelForScreenSize(uint32_t texture, uint32_t screenSize) const
+{
+	const std::vector<MipLevel>& levels = textures[texture].levels;
+	uint32_t level = 0;
+	while (level + 1 < levels.size() && std::max(levels[level + 1].width, levels[level + 1].height) >= screenSize)
+		level++;																//      
+	return level;
+}
+
+void TextureManager::requestLevel(uint32_t texture, uint32_t level)
+{
+	textures[texture].requestedLevel = std::min(level, textures[texture].tailLevel);
+}
+
+void TextureManager::setResidencyBudget(VkDeviceSize budget)
+{
+	residencyBudget = budget;
+}
+
+uint32_t TextureManager::streamMips(VkDeviceSize maxBytes, uint64_t frame)
+{
+	releaseImages(frame);
+
+	if (!streamUploads.empty())													//    ,     
+	{
+		if (vkGetFenceStatus(context.device, streamFence) != VK_SUCCESS)
+			return 0;
+		finishStream(frame);
+	}
+
+	std::vector<VkDeviceSize> offsets;											//       
+	std::vector<bool> selected(textures.size(), false);
+	VkDeviceSize stagingSize = 0;
+	VkDeviceSize uploadedBytes = 0;
+
+	for (uint32_t i = 0; i < textures.size(); i++)								//  ,     
+	{
+		Texture& texture = textures[i];
+		if (texture.requestedLevel <= texture.residentLevel + 1)				//   ,         
+			continue;
+
+		VkMemoryRequirements requirements;
+		VkImage image = createImage(texture, texture.requestedLevel, requirements);
+		selected[i] = true;
+		streamUploads.push_back({ i, texture.requestedLevel, image, allocateImageMemory(image, requirements), requirements.size });
+		allocatedBytes -= texture.allocatedBytes - requirements.size;
+		for (uint32_t level = texture.residentLevel; level < texture.requestedLevel; level++)
+			residentBytes -= texture.levels[level].byteLength;
+		offsets.push_back(0);													//    ,   
+	}
+
+	for (;;)
+	{
+		uint32_t next = UINT32_MAX;												//     ,    
+		for (uint32_t i = 0; i < textures.size(); i++)
+		{
+			const Texture& texture = textures[i];
+			if (!selected[i] && texture.residentLevel > texture.requestedLevel &&
+				(next == UINT32_MAX || texture.residentLevel > textures[next].residentLevel))
+				next = i;
+		}
+		if (next == UINT32_MAX)
+			break;
+
+		const Texture& texture = textures[next];
+		uint32_t level = texture.residentLevel - 1;
+		VkDeviceSize levelBytes = texture.levels[level].byteLength;
+		if (!streamUploads.empty() && uploadedBytes + levelBytes > maxBytes)	//     ,      
+			break;
+
+		VkMemoryRequirements requirements;										//    ,  -   
+		VkImage image = createImage(texture, level, requirements);
+		if (allocatedBytes - texture.allocatedBytes + requirements.size > residencyBudget)
+		{
+			vkDestroyImage(context.device, image, nullptr);
+			break;
+		}
+
+		selected[next] = true;
+		streamUploads.push_back({ next, level, image, allocateImageMemory(image, requirements), requirements.size });
+		allocatedBytes += requirements.size - texture.allocatedBytes;			//       
+		stagingSize = layoutLevels(texture, level, level + 1, stagingSize, offsets);
+		uploadedBytes += levelBytes;
+	}
+
+	if (streamUploads.empty())
+		return 0;
+
+	void* mapped = nullptr;
+	if (stagingSize != 0)														//         
+	{
+		createBuffer(context, stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, streamStagingBuffer, streamStagingMemory);
+		vkMapMemory(context.device, streamStagingMemory, 0, stagingSize, 0, &mapped);
+	}
+
+	streamCommandBuffer = beginSingleTimeCommands(context);
+	for (size_t i = 0; i < streamUploads.size(); i++)							//     ,    
+	{
+		const StreamUpload& upload = streamUploads[i];
+		const Texture& texture = textures[upload.texture];
+		recordCopyResident(streamCommandBuffer, texture, upload.image, upload.level, std::max(upload.level, texture.residentLevel));
+		if (upload.level < texture.residentLevel)
+			recordUpload(streamCommandBuffer, texture, upload.image, upload.level, upload.level, upload.level + 1, mapped, streamStagingBuffer, &offsets[i]);
+	}
+	vkEndCommandBuffer(streamCommandBuffer);
+
+	VkSubmitInfo submitInfo{};													//    ,   
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &streamCommandBuffer;
+
+	if (vkQueueSubmit(context.queue, 1, &submitInfo, streamFence) != VK_SUCCESS)
+		throw std::runtime_error("Failed to submit texture streaming commands!");
+
+	residentBytes += uploadedBytes;
+
+	return static_cast<uint32_t>(streamUploads.size());
+}
+
+void TextureManager::printStats() const
+{
+	double totalLoadMs = 0.0;
+	size_t mappedBytes = 0;
+
+	for (const auto& texture : textures)
+	{
+		totalLoadMs += texture.loadTimeMs;
+		mappedBytes += texture.file.size();
+		std::cout << "Texture " << texture.name << ": load " << texture.loadTimeMs << " ms, resident level "
+			<< texture.residentLevel << "/" << texture.levels.size() << ", " << texture.residentBytes << " bytes in "
+			<< texture.allocatedBytes << " allocated" << std::endl;
+	}
+
+	std::cout << "Textures: " << textures.size() << ", load " << totalLoadMs << " ms, resident " << residentBytes
+		<< " bytes of " << allocatedBytes << " allocated (budget " << residencyBudget << "), mapped " << mappedBytes << " bytes" << std::endl;
+}
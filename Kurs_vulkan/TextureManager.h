@@ -0,0 +1,104 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "MappedFile.h"
+#include "VulkanUtils.h"
+
+class TextureManager												//  KTX2        -
+{
+private:
+	struct MipLevel													//  -  KTX2 
+	{
+		uint64_t byteOffset;										//      
+		uint64_t byteLength;										//   
+		uint32_t width;												//    
+		uint32_t height;											//    
+	};
+	struct Texture
+	{
+		std::string name;											//     
+		MappedFile file;											//  KTX2 ,      
+		VkFormat format = VK_FORMAT_UNDEFINED;						// ,    
+		uint32_t blockSize = 0;										//         
+		std::vector<MipLevel> levels;								// -, 0 -  
+		VkImage image = VK_NULL_HANDLE;								//     ,  0 - residentLevel
+		VkDeviceMemory memory = VK_NULL_HANDLE;						//  
+		VkImageView imageView = VK_NULL_HANDLE;						// View    
+		uint32_t residentLevel = 0;									//     (levels.size() -   )
+		uint32_t requestedLevel = 0;								//   ,   ,   
+		uint32_t tailLevel = 0;										//   ,   ,   
+		VkDeviceSize allocatedBytes = 0;							//    
+		VkDeviceSize residentBytes = 0;								//   -
+		double loadTimeMs = 0.0;									//   
+	};
+
+	struct StreamUpload												//    
+	{
+		uint32_t texture;
+		uint32_t level;												//  residentLevel ,    
+		VkImage image;												//    [level, levels.size()),  
+		VkDeviceMemory memory;
+		VkDeviceSize allocatedBytes;
+	};
+	struct RetiredImage												//  ,       
+	{
+		VkImageView view;
+		VkImage image;
+		VkDeviceMemory memory;
+		uint64_t frame;												//  ,   
+	};
+
+	VulkanContext context;											// ,      
+	VkPhysicalDeviceFeatures deviceFeatures{};						//     
+	std::vector<Texture> textures;									//  
+	VkDeviceSize residencyBudget;									//    
+	VkDeviceSize allocatedBytes = 0;								//      
+	VkDeviceSize residentBytes = 0;									//    -
+	const uint32_t tailSize = 64;									//       
+	uint32_t framesInFlight = 1;									//  ,     view
+	VkFence streamFence = VK_NULL_HANDLE;							//   ,   
+	VkCommandBuffer streamCommandBuffer = VK_NULL_HANDLE;			//    
+	VkBuffer streamStagingBuffer = VK_NULL_HANDLE;					//     
+	VkDeviceMemory streamStagingMemory = VK_NULL_HANDLE;
+	std::vector<StreamUpload> streamUploads;						//    ,  -  
+	std::vector<RetiredImage> retiredImages;						// ,   
+
+	std::vector<std::string> candidateFiles(const std::string& name);	//       
+	bool isFormatSupported(VkFormat format);						//       
+	void parseKtx2(Texture& texture);								//      KTX2
+	VkImage createImage(const Texture& texture, uint32_t firstLevel, VkMemoryRequirements& requirements);	//     [firstLevel, levels.size())  
+	VkDeviceMemory allocateImageMemory(VkImage image, const VkMemoryRequirements& requirements);	//     
+	VkDeviceSize layoutLevels(const Texture& texture, uint32_t firstLevel, uint32_t lastLevel, VkDeviceSize stagingSize,
+		std::vector<VkDeviceSize>& offsets);						//       stagingSize,   
+	void recordUpload(VkCommandBuffer commandBuffer, const Texture& texture, VkImage image, uint32_t baseLevel, uint32_t firstLevel,
+		uint32_t lastLevel, void* mapped, VkBuffer stagingBuffer, const VkDeviceSize* offsets);	//          image   0 = baseLevel
+	void recordCopyResident(VkCommandBuffer commandBuffer, const Texture& texture, VkImage image, uint32_t baseLevel,
+		uint32_t firstLevel);										//    [firstLevel, levels.size())     
+	void uploadLevels(Texture& texture, uint32_t firstLevel, uint32_t lastLevel);	//   [firstLevel, lastLevel)  ,   
+	void createImageView(Texture& texture);											//  view    
+	void releaseImages(uint64_t frame);												//  ,       
+	void finishStream(uint64_t frame);								//    
+public:
+	TextureManager(VkDeviceSize residencyBudget = 256ull * 1024 * 1024);
+
+	void init(const VulkanContext& context, uint32_t framesInFlight);	//   
+	void cleanup();													//   
+	uint32_t loadTexture(const std::string& name);					//  ,   
+	void loadDirectory(const std::string& directory);				//     
+	uint32_t findTexture(const std::string& name) const;			//         , UINT32_MAX  
+	uint32_t levelForScreenSize(uint32_t texture, uint32_t screenSize) const;	//   ,   screenSize 
+	void requestLevel(uint32_t texture, uint32_t level);			//    ,    
+	void setResidencyBudget(VkDeviceSize budget);					//    
+	uint32_t streamMips(VkDeviceSize maxBytes, uint64_t frame);		//      , maxBytes    ,      frame
+	size_t getTextureCount() const { return textures.size(); }
+	VkImageView getImageView(uint32_t texture) const { return textures[texture].imageView; }
+	uint32_t getResidentLevel(uint32_t texture) const { return textures[texture].residentLevel; }
+	VkDeviceSize getResidentBytes() const { return residentBytes; }
+	VkDeviceSize getAllocatedBytes() const { return allocatedBytes; }
+	void printStats() const;										//      
+};
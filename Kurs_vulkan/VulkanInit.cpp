@@ -6,61 +6,366 @@
 
 void VulkanInit::initWindow()
 {
-	glfwInit();																//   GLFW
-
 	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);							//  OpenGl
 	glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);								//   
 
-	window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan", nullptr, nullptr);	//  
+	targets.resize(outputCount);
+	for (uint32_t i = 0; i < outputCount; i++)								//  
+	{
+		targets[i].createWindow(WIDTH, HEIGHT, i == 0 ? "Vulkan" : "Vulkan " + std::to_string(i + 1));
+
+		GLFWwindow* window = targets[i].getWindow();
+		glfwSetWindowUserPointer(window, this);
+		glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+		glfwSetKeyCallback(window, keyCallback);
+		glfwSetCursorPosCallback(window, cursorPosCallback);
+		glfwSetMouseButtonCallback(window, mouseButtonCallback);
+	}
 }
 
 void VulkanInit::initVulkan()
 {
-	createInstance();
-	createSurface();
-	pickPhysicalDevice();
-	createLogicalDevice();
-	createSwapChain();
-	createImageViews();
-	createRenderPass();
-	createGraphicsPipeline();
-	createFramebuffers();
+	StartupGraph startup;													//       
+
+	if (enableValidationsLayers)
+		debugLog.start();													//      
+
+	auto glfwNode = startup.addNode("glfwInit", [] {
+		if (glfwInit() != GLFW_TRUE)										//   GLFW
+			throw std::runtime_error("Failed to initialize GLFW!");
+	}, {}, true);
+	auto shadersNode = startup.addNode("loadShaders", [this] { loadShaders(); });
+	auto cacheFileNode = startup.addNode("readPipelineCache", [this] { readPipelineCacheFile(); });
+	auto windowNode = startup.addNode("initWindow", [this] { initWindow(); }, { glfwNode }, true);	//  GLFW     
+	auto instanceNode = startup.addNode("createInstance", [this] { createInstance(); }, { glfwNode });
+	startup.addNode("setupDebugMessenger", [this] { setupDebugMessenger(); }, { instanceNode });
+	auto devicesNode = startup.addNode("enumerateDevices", [this] { enumeratePhysicalDevices(); }, { instanceNode });
+	auto surfaceNode = startup.addNode("createSurface", [this] { createSurface(); }, { instanceNode, windowNode });
+	auto physicalNode = startup.addNode("pickPhysicalDevice", [this] { pickPhysicalDevice(); }, { devicesNode, surfaceNode });
+	auto deviceNode = startup.addNode("createLogicalDevice", [this] { createLogicalDevice(); }, { physicalNode });
+	auto swapChainNode = startup.addNode("createSwapChain", [this] { createSwapChain(); }, { deviceNode });
+	auto viewsNode = startup.addNode("createImageViews", [this] { createImageViews(); }, { swapChainNode });
+	auto renderPassNode = startup.addNode("createRenderPass", [this] { createRenderPass(); }, { swapChainNode });
+	auto cacheNode = startup.addNode("createPipelineCache", [this] { createPipelineCache(); }, { deviceNode, cacheFileNode });
+	startup.addNode("createPipeline", [this] { createGraphicsPipeline(); }, { renderPassNode, shadersNode, cacheNode });
+	auto framebuffersNode = startup.addNode("createFramebuffers", [this] { createFramebuffers(); }, { viewsNode, renderPassNode });
+	auto commandPoolNode = startup.addNode("createCommandPool", [this] { createCommandPool(); }, { deviceNode });
+	startup.addNode("createSyncObjects", [this] { createSyncObjects(); }, { swapChainNode });
+	auto instanceBufferNode = startup.addNode("createInstanceBuffer", [this] { createInstanceBuffer(); }, { commandPoolNode });	// getContext()  commandPool
+	auto texturesNode = startup.addNode("createTextures", [this] { createTextures(); }, { commandPoolNode });
+	auto meshesNode = startup.addNode("createMeshes", [this] { createMeshes(); }, { texturesNode });	//      ,    
+	auto lodSelectorNode = startup.addNode("createLodSelector", [this] { createLodSelector(); }, { meshesNode, instanceBufferNode, cacheNode, shadersNode });
+	startup.addNode("createMeshRenderer", [this] { createMeshRenderer(); }, { lodSelectorNode, renderPassNode });
+	startup.addNode("createCommandBuffers", [this] { createCommandBuffers(); }, { meshesNode, framebuffersNode });	//      
+
+	startup.run(taskPool);
+	startup.printStats();													//      
 }
 
 void VulkanInit::mainLoop()
 {
-	while (!glfwWindowShouldClose(window))									//   ,   
+	renderRunning = true;
+	renderThread = std::thread(&VulkanInit::renderLoop, this);				//         
+
+	auto windowClosed = [this] {											//     
+		for (const auto& target : targets)
+		{
+			if (glfwWindowShouldClose(target.getWindow()))
+				return true;
+		}
+		return false;
+	};
+
+	while (!windowClosed() && renderRunning)								//   ,   
 	{
-		glfwPollEvents();													//     
+		glfwWaitEvents();													//   , callbacks     
 	}
+
+	renderStop = true;
+	renderThread.join();
+
+	if (renderError)														//       main
+		std::rethrow_exception(renderError);
 }
 
-void VulkanInit::cleanup()
+void VulkanInit::renderLoop()
 {
-	vkDestroyCommandPool(device, commandPool, nullptr);						//   
+	try
+	{
+		lastPresent = std::chrono::steady_clock::now();
+
+		while (!renderStop)
+		{
+			processWindowEvents();
+
+			if (std::all_of(targets.begin(), targets.end(), [](const PresentTarget& target) { return target.isMinimized(); }))	//   ,  
+			{
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+				continue;
+			}
+
+			drawFrame();
+		}
+
+		vkDeviceWaitIdle(device);											//     
+	}
+	catch (...)
+	{
+		renderError = std::current_exception();
+	}
+
+	renderRunning = false;
+	glfwPostEmptyEvent();													//   
+}
+
+void VulkanInit::processWindowEvents()
+{
+	WindowEvent event;
+	while (windowEvents.tryPop(event))
+	{
+		eventLatency.add(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - event.timestamp).count());
+
+		switch (event.type)
+		{
+		case WindowEvent::Type::Resize:
+			targets[event.target].setFramebufferSize(static_cast<int>(event.x), static_cast<int>(event.y));
+			break;
+		default:															//      
+			break;
+		}
+	}
+}
+
+void VulkanInit::pushWindowEvent(WindowEvent event)
+{
+	event.timestamp = std::chrono::steady_clock::now();
+	if (!windowEvents.tryPush(event))										//       
+		droppedEvents++;
+}
+
+void VulkanInit::framebufferResizeCallback(GLFWwindow* window, int width, int height)
+{
+	auto app = reinterpret_cast<VulkanInit*>(glfwGetWindowUserPointer(window));
+	app->pushWindowEvent({ WindowEvent::Type::Resize, app->findTarget(window), 0, 0, 0, double(width), double(height) });
+}
+
+void VulkanInit::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+	auto app = reinterpret_cast<VulkanInit*>(glfwGetWindowUserPointer(window));
+	app->pushWindowEvent({ WindowEvent::Type::Key, app->findTarget(window), key, action, mods, 0.0, 0.0 });
+}
+
+void VulkanInit::cursorPosCallback(GLFWwindow* window, double x, double y)
+{
+	auto app = reinterpret_cast<VulkanInit*>(glfwGetWindowUserPointer(window));
+	app->pushWindowEvent({ WindowEvent::Type::CursorMove, app->findTarget(window), 0, 0, 0, x, y });
+}
 
-	for (auto framebuffer : swapChainFramebuffers) {						//   
-		vkDestroyFramebuffer(device, framebuffer, nullptr);
+void VulkanInit::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
+{
+	auto app = reinterpret_cast<VulkanInit*>(glfwGetWindowUserPointer(window));
+	app->pushWindowEvent({ WindowEvent::Type::MouseButton, app->findTarget(window), button, action, mods, 0.0, 0.0 });
+}
+
+uint32_t VulkanInit::findTarget(GLFWwindow* window)
+{
+	for (uint32_t i = 0; i < targets.size(); i++)							//  ,  
+	{
+		if (targets[i].getWindow() == window)
+			return i;
 	}
 
+	return 0;
+}
+
+void VulkanInit::drawFrame()
+{
+	auto frameStart = std::chrono::steady_clock::now();
+
+	vkWaitForFences(device, 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);	//   
+
+	textureManager.streamMips(textureStreamBytes, frameNumber);						//   -   
+
+	std::vector<PresentTarget*> frameTargets;								// ,     
+	std::vector<VkSemaphore> waitSemaphores;
+	std::vector<VkPipelineStageFlags> waitStages;
+	std::vector<VkCommandBuffer> frameCommandBuffers;
+	std::vector<VkSemaphore> signalSemaphores;
+	std::vector<VkSwapchainKHR> swapChains;
+	std::vector<uint32_t> imageIndices;
+
+	for (auto& target : targets)
+	{
+		if (target.isMinimized())
+			continue;
+
+		VkResult result = target.acquireImage(currentFrame, inFlightFences[currentFrame]);
+
+		if (result == VK_ERROR_OUT_OF_DATE_KHR)							//   ,  
+		{
+			recreateSwapChain(target);
+			continue;
+		}
+		else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+			throw std::runtime_error("Failed to acquire swap chain image!");
+
+		frameTargets.push_back(&target);
+		waitSemaphores.push_back(target.getImageAvailableSemaphore(currentFrame));
+		waitStages.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+		frameCommandBuffers.push_back(target.getCommandBuffer());
+		signalSemaphores.push_back(target.getRenderFinishedSemaphore(currentFrame));
+		swapChains.push_back(target.getSwapChain());
+		imageIndices.push_back(target.getImageIndex());
+	}
+
+	if (frameTargets.empty())
+		return;
+
+	updateScene();															//       
+	updateMaterials();
+	if (lodSelectedOnGpu)													//         
+		frameCommandBuffers.insert(frameCommandBuffers.begin(), lodCommandBuffers[currentFrame]);
+
+	for (auto target : frameTargets)										//        
+		target->recordCommandBuffer(renderPass, [this, target](VkCommandBuffer commandBuffer) { recordDraws(*target, commandBuffer); });
+
+	VkSubmitInfo submitInfo{};												//       
+	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
+	submitInfo.pWaitSemaphores = waitSemaphores.data();
+	submitInfo.pWaitDstStageMask = waitStages.data();
+	submitInfo.commandBufferCount = static_cast<uint32_t>(frameCommandBuffers.size());
+	submitInfo.pCommandBuffers = frameCommandBuffers.data();
+	submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+	submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+	vkResetFences(device, 1, &inFlightFences[currentFrame]);
+	if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS)
+		throw std::runtime_error("Failed to submit draw command buffer!");
+	frameNumber++;
+
+	std::vector<VkResult> results(frameTargets.size());
+
+	VkPresentInfoKHR presentInfo{};											//       
+	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+	presentInfo.waitSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
+	presentInfo.pWaitSemaphores = signalSemaphores.data();
+	presentInfo.swapchainCount = static_cast<uint32_t>(swapChains.size());
+	presentInfo.pSwapchains = swapChains.data();
+	presentInfo.pImageIndices = imageIndices.data();
+	presentInfo.pResults = results.data();
+
+	auto presentStart = std::chrono::steady_clock::now();
+	VkResult result = vkQueuePresentKHR(presentQueue, &presentInfo);
+
+	auto now = std::chrono::steady_clock::now();
+	if (frameTime.count == 0)
+		firstFrameMs = std::chrono::duration<double, std::milli>(now - startTime).count();
+	presentTime.add(std::chrono::duration<double, std::milli>(now - presentStart).count());
+	frameTime.add(std::chrono::duration<double, std::milli>(now - frameStart).count());
+	frameInterval.add(std::chrono::duration<double, std::milli>(now - lastPresent).count());
+	lastPresent = now;
+
+	if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR)
+		throw std::runtime_error("Failed to present swap chain image!");
+
+	for (size_t i = 0; i < frameTargets.size(); i++)						//       
+	{
+		if (results[i] == VK_ERROR_OUT_OF_DATE_KHR || results[i] == VK_SUBOPTIMAL_KHR || frameTargets[i]->isResized())
+			recreateSwapChain(*frameTargets[i]);
+		else if (results[i] != VK_SUCCESS)
+			throw std::runtime_error("Failed to present swap chain image!");
+	}
+
+	currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+}
+
+void VulkanInit::printRenderStats()
+{
+	std::cout << "Time to first frame: " << firstFrameMs << " ms" << std::endl;
+	std::cout << "Render: " << frameTime.count << " frames, CPU " << frameTime.average() << " ms average / " << frameTime.maxMs
+		<< " ms max, interval " << frameInterval.average() << " ms average / " << frameInterval.maxMs << " ms max" << std::endl;
+	std::cout << "Outputs: " << targets.size() << " windows on one device, batched present " << presentTime.average() << " ms average / "
+		<< presentTime.maxMs << " ms max" << std::endl;
+	for (size_t i = 0; i < targets.size(); i++)
+		std::cout << "  output " << i << ": " << targets[i].getExtent().width << "x" << targets[i].getExtent().height << ", "
+			<< targets[i].getImageCount() << " swap chain images" << std::endl;
+	std::cout << "Events: " << eventLatency.count << " delivered, " << droppedEvents << " dropped, latency "
+		<< eventLatency.average() << " ms average / " << eventLatency.maxMs << " ms max" << std::endl;
+}
+
+void VulkanInit::recreateSwapChain(PresentTarget& target)
+{
+	if (target.isMinimized())												//  ,   
+		return;
+
+	vkDeviceWaitIdle(device);
+
+	target.recreateSwapChain(renderPass);									//           
+}
+
+void VulkanInit::createSyncObjects()
+{
+	inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+
+	VkFenceCreateInfo fenceInfo{};
+	fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;							//     
+
+	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+	{
+		if (vkCreateFence(device, &fenceInfo, nullptr, &inFlightFences[i]) != VK_SUCCESS)
+			throw std::runtime_error("Failed to create synchronization objects for a frame!");
+	}
+
+	for (auto& target : targets)											//     
+		target.createSyncObjects(MAX_FRAMES_IN_FLIGHT);
+}
+
+void VulkanInit::cleanup()
+{
+	printRenderStats();														//      
+	textureManager.printStats();											//    
+	textureManager.cleanup();												//  
+	meshManager.printStats();												//    
+	lodSelector.printStats();												//    
+	meshRenderer.cleanup();													//         
+	lodSelector.cleanup();													//      
+	meshManager.cleanup();													//   
+	scene.printStats(taskPool.getThreadCount());							//    
+
+	vkUnmapMemory(device, instanceBufferMemory);							//    
+	vkDestroyBuffer(device, instanceBuffer, nullptr);
+	vkFreeMemory(device, instanceBufferMemory, nullptr);
+
+	for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)						//  
+		vkDestroyFence(device, inFlightFences[i], nullptr);
+
+	for (auto& target : targets)											//  swap chain, surface  
+		target.cleanup(instance);
+
 	vkDestroyPipeline(device, graphicsPipeline, nullptr);					//   
 
 	vkDestroyPipelineLayout(device, pipelineLayout, nullptr);				//  Layout 
 
 	vkDestroyRenderPass(device, renderPass, nullptr);						//   
 
-	for (auto imageView : swapChainImageViews)								//    ImageView
-		vkDestroyImageView(device, imageView, nullptr);
+	vkDestroyCommandPool(device, commandPool, nullptr);						//   
 
-	vkDestroySwapchainKHR(device, swapChain, nullptr);						//  swap chain
+	savePipelineCache();													//      
 
 	vkDestroyDevice(device, nullptr);										//   
 
-	vkDestroySurfaceKHR(instance, surface, nullptr);						//   
+	if (debugMessenger != VK_NULL_HANDLE)									//   
+	{
+		auto func = (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkDestroyDebugUtilsMessengerEXT");
+		if (func != nullptr)
+			func(instance, debugMessenger, nullptr);
+	}
 
 	vkDestroyInstance(instance, nullptr);									//  
 
-	glfwDestroyWindow(window);												//  
+	debugLog.stop();														//    
 
 	glfwTerminate();														//  
 }
@@ -84,12 +389,16 @@ void VulkanInit::createInstance()
 	createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
 	createInfo.pApplicationInfo = &appInfo;
 
+	VkDebugUtilsMessengerCreateInfoEXT debugCreateInfo{};					//      
 	createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
 	createInfo.ppEnabledExtensionNames = extensions.data();
 	if (enableValidationsLayers) 
 	{
 		createInfo.enabledLayerCount = static_cast<uint32_t>(validationsLayers.size());
 		createInfo.ppEnabledLayerNames = validationsLayers.data();
+
+		populateDebugMessengerCreateInfo(debugCreateInfo);
+		createInfo.pNext = &debugCreateInfo;
 	}
 	else
 	{
@@ -100,6 +409,40 @@ void VulkanInit::createInstance()
 		throw std::runtime_error("Failed to create instance!");				//     ,   
 }
 
+void VulkanInit::populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo)
+{
+	createInfo = {};
+	createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+	createInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;	//     
+	createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+	createInfo.pfnUserCallback = debugCallback;
+	createInfo.pUserData = &debugLog;
+}
+
+void VulkanInit::setupDebugMessenger()
+{
+	if (!enableValidationsLayers)
+		return;
+
+	VkDebugUtilsMessengerCreateInfoEXT createInfo;
+	populateDebugMessengerCreateInfo(createInfo);
+
+	auto func = (PFN_vkCreateDebugUtilsMessengerEXT)vkGetInstanceProcAddr(instance, "vkCreateDebugUtilsMessengerEXT");	//    
+	if (func == nullptr || func(instance, &createInfo, nullptr, &debugMessenger) != VK_SUCCESS)
+		throw std::runtime_error("Failed to set up debug messenger!");
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL VulkanInit::debugCallback(
+	VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
+	VkDebugUtilsMessageTypeFlagsEXT messageType,
+	const VkDebugUtilsMessengerCallbackDataEXT* pCallBackData,
+	void* pUserData)
+{
+	static_cast<DebugLog*>(pUserData)->push(messageSeverity, messageType, pCallBackData);	//    Vulkan,     
+
+	return VK_FALSE;
+}
+
 bool VulkanInit::checkValidationsLayerSupport()
 {
 	uint32_t layerCount;
@@ -139,8 +482,12 @@ bool VulkanInit::isDeviceSuitable(VkPhysicalDevice device)
 
 	if (extensionsSupported)
 	{
-		SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
-		swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
+		swapChainAdequate = true;
+		for (const auto& target : targets)										// Swap chain    
+		{
+			SwapChainSupportDetails swapChainSupport = PresentTarget::querySwapChainSupport(device, target.getSurface());
+			swapChainAdequate = swapChainAdequate && !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
+		}
 	}
 
 	return indices.isComplete() && extensionsSupported && swapChainAdequate;
@@ -164,7 +511,13 @@ VulkanInit::QueueFamilyIndices VulkanInit::findQueueFamily(VkPhysicalDevice devi
 		if (queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT)
 			indices.graphicsFamily = i;
 
-		vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);				//     surface
+		presentSupport = true;
+		for (const auto& target : targets)														//     surface  
+		{
+			VkBool32 surfaceSupport = false;
+			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, target.getSurface(), &surfaceSupport);	//     surface
+			presentSupport = presentSupport && surfaceSupport;
+		}
 
 		if (presentSupport)
 			indices.presentFamily = i;
@@ -178,7 +531,7 @@ VulkanInit::QueueFamilyIndices VulkanInit::findQueueFamily(VkPhysicalDevice devi
 	return indices;
 }
 
-void VulkanInit::pickPhysicalDevice()
+void VulkanInit::enumeratePhysicalDevices()
 {
 	uint32_t deviceCount = 0;																	//   
 	vkEnumeratePhysicalDevices(instance, &deviceCount, nullptr);
@@ -189,7 +542,16 @@ void VulkanInit::pickPhysicalDevice()
 	std::vector<VkPhysicalDevice> devices(deviceCount);											//    
 	vkEnumeratePhysicalDevices(instance, &deviceCount, devices.data());							//   
 
-	for (const auto& device : devices) {
+	for (const auto& device : devices)															// ,    surface,     
+	{
+		if (checkDeviceExtensionSupport(device))
+			candidateDevices.push_back(device);
+	}
+}
+
+void VulkanInit::pickPhysicalDevice()
+{
+	for (const auto& device : candidateDevices) {
 		if (isDeviceSuitable(device)) {
 			physicalDevice = device;
 			break;
@@ -219,7 +581,18 @@ void VulkanInit::createLogicalDevice()
 		queueCreateInfos.push_back(queueCreateInfo);
 	}
 
+	VkPhysicalDeviceFeatures supportedFeatures;
+	vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
 	VkPhysicalDeviceFeatures deviceFeatures{};													//   
+	deviceFeatures.textureCompressionBC = supportedFeatures.textureCompressionBC;				//      
+	deviceFeatures.textureCompressionETC2 = supportedFeatures.textureCompressionETC2;
+	deviceFeatures.textureCompressionASTC_LDR = supportedFeatures.textureCompressionASTC_LDR;
+	deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;						//      
+	deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;		//     firstInstance
+	deviceFeatures.shaderSampledImageArrayDynamicIndexing = supportedFeatures.shaderSampledImageArrayDynamicIndexing;	//     
+	meshFeaturesSupported = supportedFeatures.multiDrawIndirect && supportedFeatures.drawIndirectFirstInstance &&
+		supportedFeatures.shaderSampledImageArrayDynamicIndexing;
 
 	VkDeviceCreateInfo createInfo{};															// ,       
 	createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -238,8 +611,8 @@ void VulkanInit::createLogicalDevice()
 
 void VulkanInit::createSurface()
 {
-	if (glfwCreateWindowSurface(instance, window, nullptr, &surface) != VK_SUCCESS)
-		throw std::runtime_error("Failed to create window surface!");
+	for (auto& target : targets)
+		target.createSurface(instance);
 }
 
 std::vector<const char*> VulkanInit::getRequiredExtensions()
@@ -259,6 +632,21 @@ std::vector<const char*> VulkanInit::getRequiredExtensions()
 	return extensions;
 }
 
+VkFormat VulkanInit::findDepthFormat()
+{
+	const VkFormat candidates[] = { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT };
+
+	for (VkFormat format : candidates)											//  ,    
+	{
+		VkFormatProperties properties;
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &properties);
+		if (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT)
+			return format;
+	}
+
+	throw std::runtime_error("Failed to find supported depth format!");
+}
+
 bool VulkanInit::checkDeviceExtensionSupport(VkPhysicalDevice device)
 {
 	uint32_t extensionCount;
@@ -279,7 +667,7 @@ bool VulkanInit::checkDeviceExtensionSupport(VkPhysicalDevice device)
 
 void VulkanInit::run()
 {
-	initWindow();
+	startTime = std::chrono::steady_clock::now();
 	initVulkan();
 	mainLoop();
 	cleanup();
@@ -287,160 +675,21 @@ void VulkanInit::run()
 
 void VulkanInit::createSwapChain()
 {
-	SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
-
-	VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
-	VkPresentModeKHR presentMode = shooseSwapPresentMode(swapChainSupport.presentModes);
-	VkExtent2D extent = chooseSwapExtent(swapChainSupport.capabilities);
-
-	uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;							//    swap chain
-	if (swapChainSupport.capabilities.maxImageCount > 0 && imageCount > swapChainSupport.capabilities.maxImageCount)
-		imageCount = swapChainSupport.capabilities.maxImageCount;
-
-	VkSwapchainCreateInfoKHR createInfo{};															//      swap chain
-	createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
-	createInfo.surface = surface;
-	createInfo.minImageCount = imageCount;
-	createInfo.imageFormat = surfaceFormat.format;
-	createInfo.imageColorSpace = surfaceFormat.colorSpace;
-	createInfo.imageExtent = extent;
-	createInfo.imageArrayLayers = 1;
-	createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
-
 	QueueFamilyIndices indices = findQueueFamily(physicalDevice);
-	uint32_t queueFamilyIndices[] = { indices.graphicsFamily.value(), indices.presentFamily.value() };
-
-	if (indices.graphicsFamily != indices.presentFamily)
-	{
-		createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
-		createInfo.queueFamilyIndexCount = 2;
-		createInfo.pQueueFamilyIndices = queueFamilyIndices;
-	}
-	else
-	{
-		createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
-		createInfo.queueFamilyIndexCount = 0;
-		createInfo.pQueueFamilyIndices = nullptr;
-	}
-
-	createInfo.preTransform = swapChainSupport.capabilities.currentTransform;
-	createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-	createInfo.presentMode = presentMode;
-	createInfo.clipped = VK_TRUE;
-	createInfo.oldSwapchain = VK_NULL_HANDLE;
-
-	if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapChain) != VK_SUCCESS)
-		throw std::runtime_error("Failed to create swap chain!");
 
-	vkGetSwapchainImagesKHR(device, swapChain, &imageCount, nullptr);								//     swap chain
-	swapChainImage.resize(imageCount);
-	vkGetSwapchainImagesKHR(device, swapChain, &imageCount, swapChainImage.data());					//    swap chain
-
-	swapChainImageFormat = surfaceFormat.format;
-	swapChainExtent = extent;
-}
-
-VulkanInit::SwapChainSupportDetails VulkanInit::querySwapChainSupport(VkPhysicalDevice device)
-{
-	SwapChainSupportDetails details;
-
-	vkGetPhysicalDeviceSurfaceCapabilitiesKHR(device, surface, &details.capabilities);				//  surface capabilities
-
-	uint32_t formatCount;
-	vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &formatCount, nullptr);					//    
-
-	if (formatCount != 0)
-	{
-		details.formats.resize(formatCount);
-		vkGetPhysicalDeviceSurfaceFormatsKHR(device, surface, &formatCount, details.formats.data());
-	}
-
-	uint32_t presentModeCount;
-	vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &presentModeCount, nullptr);			//     
-
-	if (presentModeCount != 0)
-	{
-		details.presentModes.resize(presentModeCount);
-		vkGetPhysicalDeviceSurfacePresentModesKHR(device, surface, &presentModeCount, details.presentModes.data());
-	}
-
-	return details;
-}
-
-VkSurfaceFormatKHR VulkanInit::chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats)
-{
-	for (const auto& availableFormat : availableFormats)
-	{
-		if (availableFormat.format == VK_FORMAT_B8G8R8A8_SRGB && availableFormat.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR)
-			return availableFormat;
-	}
-
-	return availableFormats[0];
-}
-
-VkPresentModeKHR VulkanInit::shooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
-{
-	for (const auto& availablePresentMode : availablePresentModes)
-	{
-		if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR)
-			return availablePresentMode;
-	}
-
-	return VK_PRESENT_MODE_FIFO_KHR;
-}
-
-VkExtent2D VulkanInit::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
-{
-	if (capabilities.currentExtent.width != UINT32_MAX)
-		return capabilities.currentExtent;
-	else
-	{
-		int width, height;
-		glfwGetFramebufferSize(window, &width, &height);
-
-		VkExtent2D actualExtent = {
-			static_cast<uint32_t>(width),
-			static_cast<uint32_t>(height)
-		};
-
-		actualExtent.width = std::max(capabilities.minImageExtent.width, std::min(capabilities.maxImageExtent.width, actualExtent.width));
-		actualExtent.height = std::max(capabilities.minImageExtent.height, std::min(capabilities.maxImageExtent.height, actualExtent.height));
-
-		return actualExtent;
-	}
+	for (size_t i = 0; i < targets.size(); i++)								//     ,     
+		targets[i].createSwapChain(physicalDevice, device, indices.graphicsFamily.value(), indices.presentFamily.value(),
+			i == 0 ? VK_FORMAT_UNDEFINED : targets.front().getImageFormat());
 }
 
 void VulkanInit::createImageViews()
 {
-	swapChainImageViews.resize(swapChainImage.size());
-
-	for (size_t i = 0; i < swapChainImageViews.size(); i++)								//    ImageView  Image
-	{
-		VkImageViewCreateInfo createInfo{};
-		createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-		createInfo.image = swapChainImage[i];
-		createInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-		createInfo.format = swapChainImageFormat;
-		createInfo.components.r = VK_COMPONENT_SWIZZLE_IDENTITY;
-		createInfo.components.g = VK_COMPONENT_SWIZZLE_IDENTITY;
-		createInfo.components.b = VK_COMPONENT_SWIZZLE_IDENTITY;
-		createInfo.components.a = VK_COMPONENT_SWIZZLE_IDENTITY;
-		createInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		createInfo.subresourceRange.baseMipLevel = 0;
-		createInfo.subresourceRange.levelCount = 1;
-		createInfo.subresourceRange.baseArrayLayer = 0;
-		createInfo.subresourceRange.layerCount = 1;
-
-		if (vkCreateImageView(device, &createInfo, nullptr, swapChainImageViews.data()) != VK_SUCCESS)
-			throw std::runtime_error("Failed to create image views!");
-	}
+	for (auto& target : targets)
+		target.createImageViews();
 }
 
 void VulkanInit::createGraphicsPipeline()
 {
-	auto vertShaderCode = readFile("shader/vert.spv");									//   
-	auto fragShaderCode = readFile("shader/frag.spv");						
-
 	VkShaderModule vertShaderModule = createShaderModule(vertShaderCode);				//    ShaderModule
 	VkShaderModule fragShaderModule = createShaderModule(fragShaderCode);
 
@@ -470,24 +719,19 @@ void VulkanInit::createGraphicsPipeline()
 	inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 	inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-	VkViewport viewport{};						//   -       
-	viewport.x = 0.0f;
-	viewport.y = 0.0f;
-	viewport.width = (float)swapChainExtent.width;
-	viewport.height = (float)swapChainExtent.height;
-	viewport.minDepth = 0.0f;
-	viewport.maxDepth = 1.0f;
-
-	VkRect2D scissor{};							//  
-	scissor.offset = { 0, 0 };
-	scissor.extent = swapChainExtent;
-
 	VkPipelineViewportStateCreateInfo viewportState{};									//    viewport  scissor
 	viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
 	viewportState.viewportCount = 1;
-	viewportState.pViewports = &viewport;
+	viewportState.pViewports = nullptr;													//      
 	viewportState.scissorCount = 1;
-	viewportState.pScissors = &scissor;
+	viewportState.pScissors = nullptr;
+
+	VkDynamicState dynamicStates[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+
+	VkPipelineDynamicStateCreateInfo dynamicState{};									//      ,     
+	dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicState.dynamicStateCount = 2;
+	dynamicState.pDynamicStates = dynamicStates;
 
 	VkPipelineRasterizationStateCreateInfo rasterizer{};								//  
 	rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
@@ -511,6 +755,11 @@ void VulkanInit::createGraphicsPipeline()
 	multisampling.alphaToCoverageEnable = VK_FALSE;
 	multisampling.alphaToOneEnable = VK_FALSE;
 
+	VkPipelineDepthStencilStateCreateInfo depthStencil{};								//     ,    
+	depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencil.depthTestEnable = VK_FALSE;
+	depthStencil.depthWriteEnable = VK_FALSE;
+
 	VkPipelineColorBlendAttachmentState colorBlendAttachment{};							//    
 	colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
 	colorBlendAttachment.blendEnable = VK_FALSE;
@@ -552,16 +801,16 @@ void VulkanInit::createGraphicsPipeline()
 	pipelineInfo.pViewportState = &viewportState;
 	pipelineInfo.pRasterizationState = &rasterizer;
 	pipelineInfo.pMultisampleState = &multisampling;
-	pipelineInfo.pDepthStencilState = nullptr;
+	pipelineInfo.pDepthStencilState = &depthStencil;
 	pipelineInfo.pColorBlendState = &colorBlending;
-	pipelineInfo.pDynamicState = nullptr;
+	pipelineInfo.pDynamicState = &dynamicState;
 	pipelineInfo.layout = pipelineLayout;
 	pipelineInfo.renderPass = renderPass;
 	pipelineInfo.subpass = 0;
 	pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; 
 	pipelineInfo.basePipelineIndex = -1; 
 	//   
-	if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {	
+	if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {	
 		throw std::runtime_error("failed to create graphics pipeline!");
 	}
 
@@ -569,10 +818,90 @@ void VulkanInit::createGraphicsPipeline()
 	vkDestroyShaderModule(device, fragShaderModule, nullptr);
 }
 
+void VulkanInit::loadShaders()
+{
+	vertShaderCode = readFile("shader/vert.spv");										//   ,      swap chain
+	fragShaderCode = readFile("shader/frag.spv");
+
+	std::ifstream lodShader("shader/lod_select_comp.spv");
+	if (lodShader.is_open())															//     
+		lodShaderCode = readFile("shader/lod_select_comp.spv");
+
+	std::ifstream meshShader("shader/mesh_vert.spv");
+	if (meshShader.is_open())															//     ,  
+	{
+		meshVertShaderCode = readFile("shader/mesh_vert.spv");
+		meshFragShaderCode = readFile("shader/mesh_frag.spv");
+	}
+}
+
+void VulkanInit::readPipelineCacheFile()
+{
+	std::ifstream file(pipelineCacheFile, std::ios::ate | std::ios::binary);
+
+	if (!file.is_open())																//  ,   
+		return;
+
+	pipelineCacheData.resize((size_t)file.tellg());
+	file.seekg(0);
+	file.read(pipelineCacheData.data(), pipelineCacheData.size());
+}
+
+void VulkanInit::createPipelineCache()
+{
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+	bool valid = pipelineCacheData.size() >= 4 * sizeof(uint32_t) + VK_UUID_SIZE;		// : , , vendorID, deviceID, UUID 
+	if (valid)
+	{
+		uint32_t header[4];
+		memcpy(header, pipelineCacheData.data(), sizeof(header));
+		valid = header[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE && header[2] == properties.vendorID && header[3] == properties.deviceID &&
+			memcmp(pipelineCacheData.data() + sizeof(header), properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+	}
+	if (!valid)																			//        
+		pipelineCacheData.clear();
+
+	VkPipelineCacheCreateInfo createInfo{};
+	createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	createInfo.initialDataSize = pipelineCacheData.size();
+	createInfo.pInitialData = pipelineCacheData.data();
+
+	if (vkCreatePipelineCache(device, &createInfo, nullptr, &pipelineCache) != VK_SUCCESS)
+		throw std::runtime_error("Failed to create pipeline cache!");
+
+	pipelineCacheLoadedBytes = pipelineCacheData.size();
+	std::vector<char>().swap(pipelineCacheData);
+}
+
+void VulkanInit::savePipelineCache()
+{
+	size_t dataSize = 0;
+	vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr);
+
+	std::vector<char> data(dataSize);
+	vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data());
+
+	std::string tempFile = pipelineCacheFile + ".tmp";									//    ,       
+	std::ofstream file(tempFile, std::ios::binary | std::ios::trunc);
+	if (file.is_open())
+	{
+		file.write(data.data(), dataSize);
+		file.close();
+		std::remove(pipelineCacheFile.c_str());
+		std::rename(tempFile.c_str(), pipelineCacheFile.c_str());
+	}
+
+	std::cout << "Pipeline cache: " << pipelineCacheLoadedBytes << " bytes loaded, " << dataSize << " bytes saved" << std::endl;
+
+	vkDestroyPipelineCache(device, pipelineCache, nullptr);
+}
+
 void VulkanInit::createRenderPass()
 {
 	VkAttachmentDescription colorAttachment{};					//   
-	colorAttachment.format = swapChainImageFormat;
+	colorAttachment.format = targets.front().getImageFormat();	//    swap chain  
 	colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
 	colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 	colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
@@ -581,21 +910,50 @@ void VulkanInit::createRenderPass()
 	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
+	depthFormat = findDepthFormat();
+
+	VkAttachmentDescription depthAttachment{};					//  ,    
+	depthAttachment.format = depthFormat;
+	depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+	depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
 	VkAttachmentReference colorAttachmentRef{};					//       
 	colorAttachmentRef.attachment = 0;
 	colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+	VkAttachmentReference depthAttachmentRef{};
+	depthAttachmentRef.attachment = 1;
+	depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
 	VkSubpassDescription subpass{};								//  
 	subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 	subpass.colorAttachmentCount = 1;
 	subpass.pColorAttachments = &colorAttachmentRef;
+	subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+	VkSubpassDependency dependency{};							//         swap chain,    -   
+	dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+	dependency.dstSubpass = 0;
+	dependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	dependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+	dependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+	VkAttachmentDescription attachments[] = { colorAttachment, depthAttachment };
 
 	VkRenderPassCreateInfo renderPassInfo{};					//   
 	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassInfo.attachmentCount = 1;
-	renderPassInfo.pAttachments = &colorAttachment;
+	renderPassInfo.attachmentCount = 2;
+	renderPassInfo.pAttachments = attachments;
 	renderPassInfo.subpassCount = 1;
 	renderPassInfo.pSubpasses = &subpass;
+	renderPassInfo.dependencyCount = 1;
+	renderPassInfo.pDependencies = &dependency;
 
 	if (vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {		//   
 		throw std::runtime_error("Failed to create render pass!");
@@ -604,26 +962,8 @@ void VulkanInit::createRenderPass()
 
 void VulkanInit::createFramebuffers()
 {
-	swapChainFramebuffers.resize(swapChainImageViews.size());
-
-	for (size_t i = 0; i < swapChainImageViews.size(); i++) {
-		VkImageView attachments[] = {
-			swapChainImageViews[i]
-		};
-
-		VkFramebufferCreateInfo framebufferInfo{};
-		framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-		framebufferInfo.renderPass = renderPass;
-		framebufferInfo.attachmentCount = 0;
-		framebufferInfo.pAttachments = attachments;
-		framebufferInfo.width = swapChainExtent.width;
-		framebufferInfo.height = swapChainExtent.height;
-		framebufferInfo.layers = 1;
-
-		if (vkCreateFramebuffer(device, &framebufferInfo, nullptr, &swapChainFramebuffers[i]) != VK_SUCCESS) {
-			throw std::runtime_error("failed to create framebuffer!");
-		}
-	}
+	for (auto& target : targets)
+		target.createFramebuffers(renderPass, depthFormat);
 }
 
 void VulkanInit::createCommandPool()
@@ -633,7 +973,7 @@ void VulkanInit::createCommandPool()
 	VkCommandPoolCreateInfo poolInfo{};					//   
 	poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
 	poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
-	poolInfo.flags = 0; 
+	poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;	//      
 
 	if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {		//   
 		throw std::runtime_error("failed to create command pool!");
@@ -642,50 +982,184 @@ void VulkanInit::createCommandPool()
 
 void VulkanInit::createCommandBuffers()
 {
-	commandBuffers.resize(swapChainFramebuffers.size());
+	for (auto& target : targets)
+		target.createCommandBuffers(commandPool);
+
+	lodCommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
 
-	VkCommandBufferAllocateInfo allocInfo{};					//      
+	VkCommandBufferAllocateInfo allocInfo{};
 	allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 	allocInfo.commandPool = commandPool;
 	allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	allocInfo.commandBufferCount = (uint32_t)commandBuffers.size();
+	allocInfo.commandBufferCount = MAX_FRAMES_IN_FLIGHT;
+
+	if (vkAllocateCommandBuffers(device, &allocInfo, lodCommandBuffers.data()) != VK_SUCCESS)
+		throw std::runtime_error("Failed to allocate LOD command buffers!");
+}
 
-	if (vkAllocateCommandBuffers(device, &allocInfo, commandBuffers.data()) != VK_SUCCESS) {		//  
-		throw std::runtime_error("failed to allocate command buffers!");
+void VulkanInit::recordDraws(PresentTarget& target, VkCommandBuffer commandBuffer)
+{
+	if (!meshRenderer.isReady())												//     
+	{
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+		vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+		return;
 	}
 
-	for (size_t i = 0; i < commandBuffers.size(); i++) {				//   
-		VkCommandBufferBeginInfo beginInfo{};
-		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		beginInfo.flags = 0; 
-		beginInfo.pInheritanceInfo = nullptr; 
+	VkExtent2D extent = target.getExtent();
+	float viewProjection[16];
+	MeshRenderer::makeViewProjection(cameraEye, cameraTarget, cameraFovY, float(extent.width) / float(std::max(extent.height, 1u)),
+		cameraNear, cameraFar, viewProjection);
+	meshRenderer.recordDraws(commandBuffer, currentFrame, viewProjection, lodSelector.getIndirectBuffer(),
+		lodSelector.getIndirectOffset(currentFrame), lodDrawCount);				//      updateScene
+}
 
-		if (vkBeginCommandBuffer(commandBuffers[i], &beginInfo) != VK_SUCCESS) {
-			throw std::runtime_error("failed to begin recording command buffer!");
-		}
+void VulkanInit::createTextures()
+{
+	textureManager.init(getContext(), MAX_FRAMES_IN_FLIGHT);
+	textureManager.loadDirectory("textures");									//   -,   -  requestLevel
+}
 
-		VkRenderPassBeginInfo renderPassInfo{};							//      
-		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassInfo.renderPass = renderPass;
-		renderPassInfo.framebuffer = swapChainFramebuffers[i];
-		renderPassInfo.renderArea.offset = { 0, 0 };
-		renderPassInfo.renderArea.extent = swapChainExtent;
+void VulkanInit::createMeshes()
+{
+	meshManager.init(getContext());
+	meshManager.loadDirectory("models");										//    ,     .mesh
+	meshManager.upload();														//       
+}
 
-		VkClearValue clearColor = { 0.0f, 0.0f, 0.0f, 1.0f };			//   -       
-		renderPassInfo.clearValueCount = 1;
-		renderPassInfo.pClearValues = &clearColor;
+void VulkanInit::createLodSelector()
+{
+	lodSelector.init(getContext(), meshManager, MAX_FRAMES_IN_FLIGHT, maxSceneObjects, triangleBudget);
 
-		vkCmdBeginRenderPass(commandBuffers[i], &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE); //   
-		vkCmdBindPipeline(commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline); //   
-		vkCmdDraw(commandBuffers[i], 3, 1, 0, 0);	//  
+	const std::vector<MeshLodInfo>& meshes = meshManager.getLodInfos();
+	if (meshes.empty())
+		return;
 
-		vkCmdEndRenderPass(commandBuffers[i]);	//   
-		if (vkEndCommandBuffer(commandBuffers[i]) != VK_SUCCESS) {	//    
-			throw std::runtime_error("failed to record command buffer!");
-		}
+	float spacing = 0.0f;														//     
+	for (const auto& mesh : meshes)
+		spacing = std::max(spacing, mesh.boundingSphere[3] * 2.5f);
+
+	const float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	const float scale[3] = { 1.0f, 1.0f, 1.0f };
+	for (uint32_t i = 0; i < sceneGridSize * sceneGridSize; i++)				//     
+	{
+		uint32_t object = scene.addObject();
+		float position[3] = { (float(i % sceneGridSize) - sceneGridSize * 0.5f) * spacing, 0.0f, -float(i / sceneGridSize) * spacing };
+		scene.setTransform(object, position, rotation, scale);
+		lodSelector.addObject(object, i % static_cast<uint32_t>(meshes.size()));
 	}
 
-	
+	cameraEye[1] = spacing * 2.0f;
+	cameraEye[2] = spacing * 2.0f;
+	cameraTarget[2] = -spacing * sceneGridSize * 0.5f;
+
+	if (preferGpuLodSelect && lodShaderCode.empty())
+		throw std::runtime_error("LOD selection shader is missing, run shader/compile.bat!");
+	if (!lodShaderCode.empty())
+		lodSelector.initGpu(lodShaderCode, pipelineCache, instanceBuffer, Scene::getSlotSize(maxSceneObjects));
+}
+
+void VulkanInit::createMeshRenderer()
+{
+	if (meshManager.getLodInfos().empty())										//    
+		return;
+	if (meshVertShaderCode.empty())
+		throw std::runtime_error("Mesh shaders are missing, run shader/compile.bat!");
+	if (!meshFeaturesSupported)													//      
+	{
+		std::cout << "Meshes: multiDrawIndirect, drawIndirectFirstInstance or shaderSampledImageArrayDynamicIndexing is not supported, "
+			"drawing the triangle" << std::endl;
+		return;
+	}
+
+	meshTextures.assign(meshManager.getMeshCount(), UINT32_MAX);				// models/name.obj   textures/name
+	for (uint32_t mesh = 0; mesh < meshTextures.size(); mesh++)
+		meshTextures[mesh] = textureManager.findTexture(std::filesystem::path(meshManager.getMeshName(mesh)).stem().string());
+
+	meshRenderer.init(getContext(), meshManager, meshVertShaderCode, meshFragShaderCode, renderPass, pipelineCache, MAX_FRAMES_IN_FLIGHT,
+		lodSelector.getObjectBuffer(), lodSelector.getObjectSlotSize(), instanceBuffer, Scene::getSlotSize(maxSceneObjects),
+		meshTextures, static_cast<uint32_t>(textureManager.getTextureCount()));
+}
+
+void VulkanInit::createInstanceBuffer()
+{
+	VkDeviceSize bufferSize = MAX_FRAMES_IN_FLIGHT * Scene::getSlotSize(maxSceneObjects);
+
+	createBuffer(getContext(), bufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, instanceBuffer, instanceBufferMemory);
+
+	vkMapMemory(device, instanceBufferMemory, 0, bufferSize, 0, &instanceBufferMapped);	//      
+}
+
+void VulkanInit::updateScene()
+{
+	if (scene.getObjectCount() > maxSceneObjects)
+		throw std::runtime_error("Scene has more objects than the instance buffer can hold!");
+
+	uint8_t* slot = static_cast<uint8_t*>(instanceBufferMapped) + currentFrame * Scene::getSlotSize(maxSceneObjects);
+	scene.update(taskPool, slot, currentFrame);									//    
+
+	lodDrawCount = 0;
+	lodSelectedOnGpu = false;
+	if (lodSelector.getObjectCount() == 0 || !meshRenderer.isReady())			//   ,    
+		return;
+
+	VkExtent2D extent = targets[0].getExtent();									//         
+	LodView view = LodSelector::makeView(cameraEye, cameraTarget, cameraFovY, float(extent.width) / float(std::max(extent.height, 1u)),
+		cameraNear, cameraFar, float(extent.height), lodPixelThreshold);
+
+	if (!preferGpuLodSelect || !lodSelector.hasGpuSelect())
+	{
+		lodDrawCount = lodSelector.select(taskPool, scene, view, currentFrame);	//      
+		return;
+	}
+
+	VkCommandBuffer commandBuffer = lodCommandBuffers[currentFrame];			//        
+	VkCommandBufferBeginInfo beginInfo{};
+	beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+	if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+		throw std::runtime_error("Failed to begin recording LOD command buffer!");
+	lodDrawCount = lodSelector.recordGpuSelect(commandBuffer, scene, view, currentFrame);	//     instanceCount = 0
+	if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+		throw std::runtime_error("Failed to record LOD command buffer!");
+
+	lodSelectedOnGpu = true;
+}
+
+void VulkanInit::updateMaterials()
+{
+	if (!meshRenderer.isReady())
+		return;
+
+	std::vector<uint32_t> levels(textureManager.getTextureCount(), UINT32_MAX);				//         
+	for (uint32_t mesh = 0; mesh < meshTextures.size(); mesh++)
+	{
+		uint32_t texture = meshTextures[mesh];
+		if (texture != UINT32_MAX)
+			levels[texture] = std::min(levels[texture], textureManager.levelForScreenSize(texture, lodSelector.getMeshScreenSize(mesh)));
+	}
+
+	std::vector<VkImageView> views(levels.size());
+	for (uint32_t texture = 0; texture < levels.size(); texture++)
+	{
+		if (levels[texture] != UINT32_MAX)													//       
+			textureManager.requestLevel(texture, levels[texture]);
+		views[texture] = textureManager.getImageView(texture);
+	}
+	meshRenderer.updateTextures(currentFrame, views);										//      
+}
+
+VulkanContext VulkanInit::getContext()
+{
+	VulkanContext context;
+	context.physicalDevice = physicalDevice;
+	context.device = device;
+	context.queue = graphicsQueue;
+	context.commandPool = commandPool;
+
+	return context;
 }
 
 VkShaderModule VulkanInit::createShaderModule(const std::vector<char>& code)
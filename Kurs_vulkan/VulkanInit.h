@@ -9,8 +9,27 @@
 #include <set>
 #include <algorithm>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+
+#include "VulkanUtils.h"
+#include "TextureManager.h"
+#include "MeshManager.h"
+#include "LodSelector.h"
+#include "MeshRenderer.h"
+#include "Scene.h"
+#include "TaskPool.h"
+#include "SpscQueue.h"
+#include "StartupGraph.h"
+#include "DebugLog.h"
+#include "PresentTarget.h"
 
 #define GLFW_INCLUDE_VULKAN
 #define VK_USE_PLATFORM_WIN32_KHR
@@ -19,33 +38,74 @@
 class VulkanInit
 {
 private:
-	GLFWwindow* window;												//  
 	VkInstance instance;											//  
 	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;				//  
-	VkDebugUtilsMessengerEXT debugMessenger;						//   
+	VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;		//   
+	DebugLog debugLog;												//     
 	VkDevice device;												//   
 	VkQueue graphicsQueue;											//   
 	VkQueue presentQueue;											//   
-	VkSurfaceKHR surface;											//     
-	VkSwapchainKHR swapChain;										//  swap chain
-	VkFormat swapChainImageFormat;									//    swap chain
-	VkExtent2D swapChainExtent;										//    swap chain
+	std::vector<PresentTarget> targets;								//  ,  ,    
 	VkRenderPass renderPass;										//  
+	VkFormat depthFormat = VK_FORMAT_UNDEFINED;						//   
 	VkPipelineLayout pipelineLayout;								// Layout 
 	VkPipeline graphicsPipeline;									//  
+	VkPipelineCache pipelineCache;									//  ,   
 	VkCommandPool commandPool;										//  
-	std::vector<VkImageView> swapChainImageViews;					//  VkImage,    
-	std::vector<VkFramebuffer> swapChainFramebuffers;				// 
-	std::vector<VkCommandBuffer> commandBuffers;					//  
+	TextureManager textureManager;									//  
+	MeshManager meshManager;										//  
+	LodSelector lodSelector;										//     
+	MeshRenderer meshRenderer;										//    
+	bool meshFeaturesSupported = false;								//  multiDrawIndirect, drawIndirectFirstInstance    
+	std::vector<uint32_t> meshTextures;								//        , UINT32_MAX -  
 	const uint32_t WIDTH = 800;										//  
 	const uint32_t HEIGHT = 600;									//  
+	const uint32_t outputCount = 2;									//   
+	const VkDeviceSize textureStreamBytes = 8 * 1024 * 1024;		//  -,   :   ,    TextureManager
+	const uint32_t MAX_FRAMES_IN_FLIGHT = 2;						//  ,  
+	const uint32_t maxSceneObjects = 16384;							//      
+	const uint32_t sceneGridSize = 32;								//      
+	const uint64_t triangleBudget = 4000000;						//   ,     
+	const float lodPixelThreshold = 1.0f;							//     
+	const float cameraFovY = 1.0472f;								//    
+	const float cameraNear = 0.1f;									//   
+	const float cameraFar = 10000.0f;								//   
+	float cameraEye[3] = { 0.0f, 0.0f, 0.0f };						//  ,    
+	float cameraTarget[3] = { 0.0f, 0.0f, -1.0f };					// ,    
+	uint32_t lodDrawCount = 0;										//      
+	const bool preferGpuLodSelect = true;							//    ,       
+	bool lodSelectedOnGpu = false;									//        
+	std::vector<VkCommandBuffer> lodCommandBuffers;					//    ,      
+	TaskPool taskPool;												//  
+	Scene scene{ MAX_FRAMES_IN_FLIGHT };							//   
+	VkBuffer instanceBuffer;										//    ,       
+	VkDeviceMemory instanceBufferMemory;							//   
+	void* instanceBufferMapped;										//    
+	uint32_t currentFrame = 0;										//    
+	uint64_t frameNumber = 0;										//   
+	std::vector<VkFence> inFlightFences;							//    ,    
+	std::thread renderThread;										//  ,      
+	std::atomic<bool> renderStop{ false };							//    
+	std::atomic<bool> renderRunning{ false };						//   
+	std::exception_ptr renderError;									// ,   
+	std::atomic<uint64_t> droppedEvents{ 0 };						// ,    
+	std::vector<char> vertShaderCode;								// SPIR-V  ,     
+	std::vector<char> fragShaderCode;								// SPIR-V  
+	std::vector<char> lodShaderCode;								// SPIR-V   ,   preferGpuLodSelect
+	std::vector<char> meshVertShaderCode;							// SPIR-V  ,    
+	std::vector<char> meshFragShaderCode;
+	std::vector<char> pipelineCacheData;							//    
+	size_t pipelineCacheLoadedBytes = 0;							//    
+	const std::string pipelineCacheFile = "pipeline_cache.bin";		//   
+	std::vector<VkPhysicalDevice> candidateDevices;					//    
+	std::chrono::steady_clock::time_point startTime;				//   
+	double firstFrameMs = 0.0;										//       
 	const std::vector<const char*> validationsLayers = {			// ,   ,   
 		"VK_LAYER_KHRONOS_validation"
 	};				
 	const std::vector<const char*> deviceExtension = {				// ,    
 		VK_KHR_SWAPCHAIN_EXTENSION_NAME
 	};
-	std::vector<VkImage> swapChainImage;							//      swap chain
 
 #ifdef NDEBUG														// ,      ,  
 	const bool enableValidationsLayers = false;						
@@ -62,36 +122,83 @@ private:
 			return graphicsFamily.has_value() && presentFamily.has_value();
 		}
 	};
-	struct SwapChainSupportDetails {								//       swap chain
-		VkSurfaceCapabilitiesKHR capabilities;						//   surface
-		std::vector<VkSurfaceFormatKHR> formats;					//  surface
-		std::vector<VkPresentModeKHR> presentModes;					//   
+	struct WindowEvent												//  ,       
+	{
+		enum class Type { Resize, Key, CursorMove, MouseButton } type;
+		uint32_t target;											// ,    
+		int code;													//    
+		int action;													// GLFW_PRESS, GLFW_RELEASE  GLFW_REPEAT
+		int mods;													// 
+		double x;													//     
+		double y;													//     
+		std::chrono::steady_clock::time_point timestamp;			//     
+	};
+	struct TimingStats												//  :   
+	{
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+		uint64_t count = 0;
+
+		void add(double ms) { totalMs += ms; maxMs = std::max(maxMs, ms); count++; }
+		double average() const { return count ? totalMs / count : 0.0; }
 	};
 
-	void initWindow();												//  
-	void initVulkan();												//  Vulkan
+	SpscQueue<WindowEvent, 1024> windowEvents;						//     
+	TimingStats eventLatency;										//    callback GLFW   
+	TimingStats frameTime;											//   CPU  
+	TimingStats frameInterval;										//    
+	TimingStats presentTime;										//    vkQueuePresentKHR   
+	std::chrono::steady_clock::time_point lastPresent;				//    
+
+	void initWindow();												//  
+	void initVulkan();												//    Vulkan  
 	void mainLoop();												//  ,     
 	void cleanup();													//     
 	void createInstance();											//   
+	void setupDebugMessenger();										//   
+	void populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo);	//    
+	void enumeratePhysicalDevices();								//      
 	void pickPhysicalDevice();										//  
 	void createLogicalDevice();										//    
-	void createSurface();											//  surface
-	void createSwapChain();											//  swap chain
+	void createSurface();											//  surface  
+	void createSwapChain();											//  swap chain  
 	void createImageViews();										//  image view
+	void loadShaders();												//  SPIR-V 
+	void readPipelineCacheFile();									//    
+	void createPipelineCache();										//      
+	void savePipelineCache();										//        
 	void createGraphicsPipeline();									//   
 	void createRenderPass();										//   
-	void createFramebuffers();										//  
+	void createFramebuffers();										//    
 	void createCommandPool();										//   
-	void createCommandBuffers();									//   
+	void createCommandBuffers();									//        
+	void recordDraws(PresentTarget& target, VkCommandBuffer commandBuffer);	//       
+	void createTextures();											//  
+	void createMeshes();											//  
+	void createInstanceBuffer();									//     
+	void createLodSelector();										//        
+	void createMeshRenderer();										//   ,      
+	void updateScene();												//        
+	void updateMaterials();											//  -         view 
+	void createSyncObjects();										//    
+	void recreateSwapChain(PresentTarget& target);					//  swap chain  
+	uint32_t findTarget(GLFWwindow* window);						//      GLFW
+	void renderLoop();												//   
+	void processWindowEvents();										//       
+	void drawFrame();												//    
+	void pushWindowEvent(WindowEvent event);						//      
+	void printRenderStats();										//      
+	static void framebufferResizeCallback(GLFWwindow* window, int width, int height);			// Callback   
+	static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);	// Callback 
+	static void cursorPosCallback(GLFWwindow* window, double x, double y);						// Callback  
+	static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);		// Callback  
+	VulkanContext getContext();										//    
 	VkShaderModule createShaderModule(const std::vector<char>& code);			//  ShaderModule
 	bool checkValidationsLayerSupport();							//     
 	bool isDeviceSuitable(VkPhysicalDevice device);					//    
 	bool checkDeviceExtensionSupport(VkPhysicalDevice device);		//    
 	QueueFamilyIndices findQueueFamily(VkPhysicalDevice device);	//    ,  
-	SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);//    SwapChainSupportDetails
-	VkSurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<VkSurfaceFormatKHR>& availableFormats);	//     
-	VkPresentModeKHR shooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);		//     
-	VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);								//    
+	VkFormat findDepthFormat();										//    ,  
 	std::vector<const char*> getRequiredExtensions();				//     
 	static std::vector<char> readFile(const std::string& filename);	//    
 	static VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(
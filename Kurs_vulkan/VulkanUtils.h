@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+struct VulkanContext												//  ,   
+{
+	VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;				//  
+	VkDevice device = VK_NULL_HANDLE;								//   
+	VkQueue queue = VK_NULL_HANDLE;									//    
+	VkCommandPool commandPool = VK_NULL_HANDLE;						//     
+};
+
+uint32_t findMemoryType(const VulkanContext& context, uint32_t typeFilter, VkMemoryPropertyFlags properties);	//    
+void createBuffer(const VulkanContext& context, VkDeviceSize size, VkBufferUsageFlags usage,
+	VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);						//       
+void createDeviceLocalBuffer(const VulkanContext& context, const void* data, VkDeviceSize size, VkBufferUsageFlags usage,
+	VkBuffer& buffer, VkDeviceMemory& bufferMemory);											//          
+void createDeviceLocalBuffer(const VulkanContext& context, VkDeviceSize size, VkBufferUsageFlags usage,
+	const std::function<void(void*)>& fill, VkBuffer& buffer, VkDeviceMemory& bufferMemory);	//  ,      
+VkCommandBuffer beginSingleTimeCommands(const VulkanContext& context);						//     
+void endSingleTimeCommands(const VulkanContext& context, VkCommandBuffer commandBuffer);	//       
@@ -1,3 +1,6 @@
 C:\VulkanSDK\1.3.246.1\Bin\glslc.exe shader.vert -o vert.spv
 C:\VulkanSDK\1.3.246.1\Bin\glslc.exe shader.frag -o frag.spv
+C:\VulkanSDK\1.3.246.1\Bin\glslc.exe mesh.vert -o mesh_vert.spv
+C:\VulkanSDK\1.3.246.1\Bin\glslc.exe mesh.frag -o mesh_frag.spv
+C:\VulkanSDK\1.3.246.1\Bin\glslc.exe lod_select.comp -o lod_select_comp.spv
 pause
\ No newline at end of file
@@ -0,0 +1,18 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(location = 0) in vec3 fragNormal;
+layout(location = 1) in vec2 fragUv;
+layout(location = 2) flat in uint fragTexture;
+
+layout(constant_id = 0) const uint textureCount = 1u;
+layout(binding = 4) uniform sampler2D textures[textureCount];
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    vec3 normal = normalize(fragNormal);
+    float light = max(dot(normal, normalize(vec3(0.4, 1.0, 0.3))), 0.0) * 0.8 + 0.2;
+    vec3 albedo = fragTexture == 0u ? normal * 0.5 + 0.5 : texture(textures[fragTexture], fragUv).rgb;
+    outColor = vec4(albedo * light, 1.0);
+}
\ No newline at end of file
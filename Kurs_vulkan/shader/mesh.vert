@@ -0,0 +1,44 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+struct LodObject {
+    uint mesh;
+    uint instance;
+};
+
+struct MeshQuantization {
+    vec4 positionScale;
+    vec4 positionOffset;
+    vec4 uvScaleOffset;
+};
+
+layout(std430, binding = 0) readonly buffer Objects { LodObject objects[]; };
+layout(std430, binding = 1) readonly buffer Instances { mat4 worldMatrices[]; };
+layout(std430, binding = 2) readonly buffer Quantization { MeshQuantization quantization[]; };
+layout(std430, binding = 3) readonly buffer Materials { uint textureSlots[]; };
+
+layout(push_constant) uniform Camera {
+    mat4 viewProjection;
+} camera;
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec4 inNormal;
+layout(location = 2) in vec2 inUv;
+
+layout(location = 0) out vec3 fragNormal;
+layout(location = 1) out vec2 fragUv;
+layout(location = 2) flat out uint fragTexture;
+
+void main() {
+    LodObject object = objects[gl_InstanceIndex];
+    MeshQuantization mesh = quantization[object.mesh];
+    mat4 world = worldMatrices[object.instance];
+
+    vec3 position = inPosition.xyz * mesh.positionScale.xyz + mesh.positionOffset.xyz;
+    vec2 uv = inUv * mesh.uvScaleOffset.xy + mesh.uvScaleOffset.zw;
+
+    gl_Position = camera.viewProjection * (world * vec4(position, 1.0));
+    fragNormal = mat3(world) * inNormal.xyz;
+    fragUv = uv;
+    fragTexture = textureSlots[object.mesh];
+}
\ No newline at end of file